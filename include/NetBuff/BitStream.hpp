@@ -0,0 +1,322 @@
+#pragma once
+
+#include "NetBuff/BitStream_fwd.hpp"
+
+#include "NetBuff/SerializeInterface.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace nb
+{
+
+/// Bits are packed from the least significant bit of each byte. (i.e. little-endian bit order)
+///
+/// Bits are batched in a 64-bit scratch, and flushed to `Buffer` by 4 bytes.
+/// So, you MUST call `align()` before writing byte-aligned fields to `Buffer` directly.
+/// (e.g. `writer.align(); buf << str;`)
+///
+/// @tparam Buffer `SerializeBuffer` or `SerializeWriter`
+template <typename Buffer>
+class BitWriter
+{
+public:
+    explicit BitWriter(Buffer& buffer) : _buffer(buffer), _scratch(0), _scratch_bits(0), _fail(false)
+    {
+    }
+
+    BitWriter(const BitWriter&) = delete;
+    BitWriter& operator=(const BitWriter&) = delete;
+
+    /// @brief Flushes the remaining bits.
+    ~BitWriter()
+    {
+        align();
+    }
+
+public:
+    /// @brief Check if write was failed once or more.
+    bool fail() const
+    {
+        return _fail;
+    }
+
+    /// @brief Check if write was not failed at all.
+    operator bool() const
+    {
+        return !fail();
+    }
+
+public:
+    /// @brief Write the lower `bits` bits of `value`.
+    bool try_write_bits(std::uint64_t value, unsigned bits)
+    {
+        assert(bits <= 64);
+
+        if (bits > available_bits())
+        {
+            _fail = true;
+            return false;
+        }
+
+        if (bits < 64)
+            value &= (std::uint64_t(1) << bits) - 1;
+
+        if (bits > 32)
+        {
+            put(value & 0xFFFF'FFFF, 32);
+            value >>= 32;
+            bits -= 32;
+        }
+        put(value, bits);
+
+        return true;
+    }
+
+    bool try_write_bool(bool value)
+    {
+        return try_write_bits(value, 1);
+    }
+
+    /// @brief Write `value` quantized to `bits` bits in the range of [`min`, `max`].
+    ///
+    /// `value` is clamped to the range. (`NaN` becomes `min`)
+    bool try_write_quantized(float value, float min, float max, unsigned bits)
+    {
+        assert(min < max && 0 < bits && bits <= 32);
+
+        const std::uint64_t steps = (std::uint64_t(1) << bits) - 1;
+
+        if (!(value >= min))
+            value = min;
+        else if (value > max)
+            value = max;
+
+        const double ratio = (static_cast<double>(value) - min) / (static_cast<double>(max) - min);
+        const auto quantized = std::min(static_cast<std::uint64_t>(ratio * static_cast<double>(steps) + 0.5), steps);
+
+        return try_write_bits(quantized, bits);
+    }
+
+    /// @brief Pad the bits to the byte boundary with `0`, and flush them to `Buffer`.
+    void align()
+    {
+        const unsigned bytes = (_scratch_bits + 7) / 8;
+        if (bytes != 0)
+            flush(bytes);
+
+        _scratch = 0;
+        _scratch_bits = 0;
+    }
+
+public:
+    /// @brief How many bits you can write before full.
+    auto available_bits() const -> std::size_t
+    {
+        return _buffer.available_space() * 8 - _scratch_bits;
+    }
+
+    /// @brief How many bits are not flushed to `Buffer` yet.
+    auto pending_bits() const -> unsigned
+    {
+        return _scratch_bits;
+    }
+
+private:
+    /// @brief Put `bits` bits of `value` to the scratch. (`bits <= 32`)
+    void put(std::uint64_t value, unsigned bits)
+    {
+        _scratch |= value << _scratch_bits;
+        _scratch_bits += bits;
+
+        if (_scratch_bits >= 32)
+        {
+            flush(4);
+            _scratch >>= 32;
+            _scratch_bits -= 32;
+        }
+    }
+
+    /// @brief Write the lowest `bytes` bytes of the scratch to `Buffer`, as little-endian.
+    void flush(unsigned bytes)
+    {
+        std::array<std::byte, 8> data;
+        for (unsigned idx = 0; idx < bytes; ++idx)
+            data[idx] = static_cast<std::byte>(_scratch >> (8 * idx));
+
+        // space is checked on `try_write_bits()`
+        [[maybe_unused]] const bool result = _buffer.try_write(data.data(), bytes);
+        assert(result);
+    }
+
+private:
+    Buffer& _buffer;
+
+    std::uint64_t _scratch;
+    unsigned _scratch_bits;
+
+    bool _fail;
+};
+
+/// Bits are unpacked from the least significant bit of each byte. (i.e. little-endian bit order)
+///
+/// Bytes are prefetched from `Buffer` to a 64-bit scratch.
+/// So, you MUST call `align()` before reading byte-aligned fields from `Buffer` directly,
+/// which skips the remaining bits of the current byte, and gives back the prefetched bytes to `Buffer`.
+/// (e.g. `reader.align(); buf >> str;`)
+///
+/// @tparam Buffer `SerializeBuffer` or `SerializeReader`
+template <typename Buffer>
+class BitReader
+{
+public:
+    explicit BitReader(Buffer& buffer) : _buffer(buffer), _scratch(0), _scratch_bits(0), _fail(false)
+    {
+    }
+
+    BitReader(const BitReader&) = delete;
+    BitReader& operator=(const BitReader&) = delete;
+
+    /// @brief Gives back the prefetched bytes.
+    ~BitReader()
+    {
+        align();
+    }
+
+public:
+    /// @brief Check if read was failed once or more.
+    bool fail() const
+    {
+        return _fail;
+    }
+
+    /// @brief Check if read was not failed at all.
+    operator bool() const
+    {
+        return !fail();
+    }
+
+public:
+    /// @brief Read `bits` bits to the lower bits of `value`.
+    bool try_read_bits(std::uint64_t& value, unsigned bits)
+    {
+        assert(bits <= 64);
+
+        if (bits > available_bits())
+        {
+            _fail = true;
+            return false;
+        }
+
+        if (bits > 32)
+        {
+            const std::uint64_t low = take(32);
+            value = low | take(bits - 32) << 32;
+        }
+        else
+        {
+            value = take(bits);
+        }
+
+        return true;
+    }
+
+    template <UnsignedInteger Num>
+    bool try_read_bits(Num& value, unsigned bits)
+    {
+        assert(bits <= std::numeric_limits<Num>::digits);
+
+        std::uint64_t value_64;
+        if (!try_read_bits(value_64, bits))
+            return false;
+
+        value = static_cast<Num>(value_64);
+        return true;
+    }
+
+    bool try_read_bool(bool& value)
+    {
+        std::uint64_t value_64;
+        if (!try_read_bits(value_64, 1))
+            return false;
+
+        value = (value_64 != 0);
+        return true;
+    }
+
+    /// @brief Read a value written with `BitWriter::try_write_quantized()` with the same parameters.
+    bool try_read_quantized(float& value, float min, float max, unsigned bits)
+    {
+        assert(min < max && 0 < bits && bits <= 32);
+
+        std::uint64_t quantized;
+        if (!try_read_bits(quantized, bits))
+            return false;
+
+        const std::uint64_t steps = (std::uint64_t(1) << bits) - 1;
+        const double ratio = static_cast<double>(quantized) / static_cast<double>(steps);
+        value = static_cast<float>(min + ratio * (static_cast<double>(max) - min));
+
+        return true;
+    }
+
+    /// @brief Skip the remaining bits of the current byte, and give back the prefetched bytes to `Buffer`.
+    void align()
+    {
+        _buffer.move_read_pos(-static_cast<std::ptrdiff_t>(_scratch_bits / 8));
+
+        _scratch = 0;
+        _scratch_bits = 0;
+    }
+
+public:
+    /// @brief How many bits you can read before empty.
+    auto available_bits() const -> std::size_t
+    {
+        return _buffer.used_space() * 8 + _scratch_bits;
+    }
+
+private:
+    /// @brief Take `bits` bits from the scratch. (`bits <= 32`)
+    auto take(unsigned bits) -> std::uint64_t
+    {
+        if (_scratch_bits < bits)
+            refill();
+
+        const std::uint64_t value = _scratch & ((std::uint64_t(1) << bits) - 1);
+        _scratch >>= bits;
+        _scratch_bits -= bits;
+
+        return value;
+    }
+
+    /// @brief Prefetch as many bytes as possible to the scratch.
+    void refill()
+    {
+        const std::size_t bytes = std::min<std::size_t>((64 - _scratch_bits) / 8, _buffer.used_space());
+        if (bytes == 0)
+            return;
+
+        std::array<std::byte, 8> data;
+        [[maybe_unused]] const bool result = _buffer.try_read(data.data(), bytes);
+        assert(result);
+
+        for (std::size_t idx = 0; idx < bytes; ++idx)
+            _scratch |= static_cast<std::uint64_t>(data[idx]) << (_scratch_bits + 8 * idx);
+        _scratch_bits += static_cast<unsigned>(8 * bytes);
+    }
+
+private:
+    Buffer& _buffer;
+
+    std::uint64_t _scratch;
+    unsigned _scratch_bits;
+
+    bool _fail;
+};
+
+} // namespace nb
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace nb
+{
+
+/// @brief Writes bit-packed fields to the storage of `Buffer`.
+template <typename Buffer>
+class BitWriter;
+
+/// @brief Reads bit-packed fields from the storage of `Buffer`.
+template <typename Buffer>
+class BitReader;
+
+} // namespace nb
@@ -0,0 +1,399 @@
+#pragma once
+
+#include "NetBuff/BlockCompressor_fwd.hpp"
+
+#include "NetBuff/SerializeBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace nb
+{
+
+/// The output is a raw LZ4 block, so any LZ4 block decoder can decompress it.
+/// As a block doesn't store its sizes, you should send the compressed size & decompressed size by yourself.
+///
+/// Compressing requires a hash table (16 KiB) inside the object,
+/// so reuse the object instead of constructing it for each message.
+/// Decompressing doesn't require any state.
+class BlockCompressor
+{
+public:
+    /// @brief Maximum distance of a match.
+    static constexpr std::size_t MAX_OFFSET = 65535;
+
+    /// @brief Maximum size of the data to compress at once.
+    static constexpr std::size_t MAX_INPUT_SIZE = 0x7E00'0000;
+
+public:
+    BlockCompressor() : _base(TABLE_BASE_INIT)
+    {
+        _table.fill(0);
+    }
+
+    BlockCompressor(const BlockCompressor&) = delete;
+    BlockCompressor& operator=(const BlockCompressor&) = delete;
+
+public:
+    /// @brief Worst case compressed size of `src_size` bytes. (i.e. Not compressible at all)
+    static constexpr auto max_compressed_size(std::size_t src_size) -> std::size_t
+    {
+        return src_size + src_size / 255 + 16;
+    }
+
+    /// @brief Compress the data to read in `src` to the end of `dest`.
+    ///
+    /// If succeeded, all the data in `src` is read.
+    /// If failed, nothing happens to both of them.
+    ///
+    /// @return `false` if `dest` doesn't have enough available space
+    template <typename SrcAllocator, std::size_t SrcInline, typename DestAllocator, std::size_t DestInline>
+    bool try_compress(SerializeBuffer<SrcAllocator, SrcInline>& src, SerializeBuffer<DestAllocator, DestInline>& dest)
+    {
+        const std::size_t compressed_size = compress(src.data() + src.read_pos(), src.used_space(),
+                                                     dest.data() + dest.write_pos(), dest.available_space());
+        if (compressed_size == 0)
+            return false;
+
+        src.move_read_pos(src.used_space());
+        dest.move_write_pos(compressed_size);
+        return true;
+    }
+
+    /// @brief Decompress the block to read in `src` to the end of `dest`.
+    ///
+    /// `dest` should be pre-sized to have enough available space for the decompressed data.
+    ///
+    /// If succeeded, all the data in `src` is read.
+    /// If failed, nothing happens to `src`, but the garbage is written to `dest` after its write position.
+    ///
+    /// @return `false` if the block is malformed, or `dest` doesn't have enough available space
+    template <typename SrcAllocator, std::size_t SrcInline, typename DestAllocator, std::size_t DestInline>
+    static bool try_decompress(SerializeBuffer<SrcAllocator, SrcInline>& src,
+                               SerializeBuffer<DestAllocator, DestInline>& dest)
+    {
+        std::size_t decompressed_size;
+        if (!try_decompress(src.data() + src.read_pos(), src.used_space(), dest.data() + dest.write_pos(),
+                            dest.available_space(), decompressed_size))
+            return false;
+
+        src.move_read_pos(src.used_space());
+        dest.move_write_pos(decompressed_size);
+        return true;
+    }
+
+public:
+    /// @brief Compress `src_size` bytes of `src` to `dest`.
+    ///
+    /// @return Compressed size, or `0` if `dest_capacity` is not enough, or `src_size > MAX_INPUT_SIZE`
+    auto compress(const std::byte* src, std::size_t src_size, std::byte* dest, std::size_t dest_capacity)
+        -> std::size_t
+    {
+        if (src_size > MAX_INPUT_SIZE)
+            return 0;
+
+        // invalidate the positions stored in the previous calls
+        if (_base > std::numeric_limits<std::uint32_t>::max() - src_size - 1)
+        {
+            _table.fill(0);
+            _base = TABLE_BASE_INIT;
+        }
+        const std::size_t base = _base;
+        _base += static_cast<std::uint32_t>(src_size + 1);
+
+        std::byte* const dest_begin = dest;
+        std::byte* const dest_end = dest + dest_capacity;
+
+        std::size_t anchor = 0;
+
+        if (src_size >= MIN_INPUT_SIZE)
+        {
+            const std::size_t match_limit = src_size - LAST_LITERALS;
+            const std::size_t match_start_limit = src_size - MATCH_FIND_LIMIT;
+
+            _table[hash(src)] = static_cast<std::uint32_t>(base);
+            std::size_t pos = 1;
+
+            while (pos < match_start_limit)
+            {
+                const std::uint32_t seq = load_u32(src + pos);
+                auto& entry = _table[hash(src + pos)];
+                const std::uint32_t candidate = std::exchange(entry, static_cast<std::uint32_t>(base + pos));
+
+                if (candidate < base || pos - (candidate - base) > MAX_OFFSET ||
+                    load_u32(src + (candidate - base)) != seq)
+                {
+                    // skip faster in the incompressible data
+                    pos += 1 + ((pos - anchor) >> SKIP_STRENGTH);
+                    continue;
+                }
+
+                std::size_t match_pos = candidate - base;
+
+                // extend backwards
+                while (pos > anchor && match_pos > 0 && src[pos - 1] == src[match_pos - 1])
+                {
+                    --pos;
+                    --match_pos;
+                }
+
+                const std::size_t match_len =
+                    MIN_MATCH + common_length(src + pos + MIN_MATCH, src + match_pos + MIN_MATCH, src + match_limit);
+
+                dest = write_sequence(dest, dest_end, src + anchor, pos - anchor, pos - match_pos, match_len);
+                if (!dest)
+                    return 0;
+
+                pos += match_len;
+                anchor = pos;
+
+                if (pos < match_start_limit)
+                    _table[hash(src + pos - 2)] = static_cast<std::uint32_t>(base + pos - 2);
+            }
+        }
+
+        // last literals
+        dest = write_sequence(dest, dest_end, src + anchor, src_size - anchor, 0, 0);
+        if (!dest)
+            return 0;
+
+        return static_cast<std::size_t>(dest - dest_begin);
+    }
+
+    /// @brief Decompress the block of `src_size` bytes of `src` to `dest`.
+    ///
+    /// @param decompressed_size Decompressed size, if succeeded
+    /// @return `false` if the block is malformed, or `dest_capacity` is not enough
+    static bool try_decompress(const std::byte* src, std::size_t src_size, std::byte* dest, std::size_t dest_capacity,
+                               std::size_t& decompressed_size)
+    {
+        const std::byte* const src_end = src + src_size;
+        std::byte* const dest_begin = dest;
+        std::byte* const dest_end = dest + dest_capacity;
+
+        while (src < src_end)
+        {
+            const auto token = static_cast<std::uint8_t>(*src++);
+
+            // literals
+            std::size_t literal_len = token >> 4;
+
+            // fast path for the short literals, which copies the fixed size
+            if (literal_len != 15 && src_end - src >= WILD_COPY_SIZE + 2 && dest_end - dest >= WILD_COPY_SIZE)
+            {
+                std::memcpy(dest, src, WILD_COPY_SIZE);
+                src += literal_len;
+                dest += literal_len;
+
+                // it's the last sequence only if `src` ends here, but that can't happen with the slack above
+                literal_len = 0;
+            }
+            else if (literal_len == 15 && !try_read_length(src, src_end, literal_len))
+                return false;
+
+            if (literal_len > static_cast<std::size_t>(src_end - src) ||
+                literal_len > static_cast<std::size_t>(dest_end - dest))
+                return false;
+
+            if (literal_len != 0) // `dest` can be `nullptr`
+                std::memcpy(dest, src, literal_len);
+            src += literal_len;
+            dest += literal_len;
+
+            // last sequence doesn't have a match
+            if (src == src_end)
+            {
+                decompressed_size = static_cast<std::size_t>(dest - dest_begin);
+                return true;
+            }
+
+            // match
+            if (src_end - src < 2)
+                return false;
+            const std::size_t offset = static_cast<std::size_t>(src[0]) | static_cast<std::size_t>(src[1]) << 8;
+            src += 2;
+            if (offset == 0 || offset > static_cast<std::size_t>(dest - dest_begin))
+                return false;
+
+            std::size_t match_len = token & 15;
+            if (match_len == 15 && !try_read_length(src, src_end, match_len))
+                return false;
+            match_len += MIN_MATCH;
+
+            if (match_len > static_cast<std::size_t>(dest_end - dest))
+                return false;
+
+            // fast path, which might write beyond the match, but not beyond `dest_end`
+            if (offset >= 8 && static_cast<std::size_t>(dest_end - dest) >= match_len + 8)
+            {
+                const std::byte* match = dest - offset;
+                for (std::size_t copied = 0; copied < match_len; copied += 8)
+                    std::memcpy(dest + copied, match + copied, 8);
+            }
+            else
+            {
+                copy_match(dest, offset, match_len);
+            }
+            dest += match_len;
+        }
+
+        // no token at all, or ended with a match
+        return false;
+    }
+
+private:
+    static constexpr std::size_t MIN_MATCH = 4;
+    static constexpr std::size_t LAST_LITERALS = 5;
+    static constexpr std::size_t MATCH_FIND_LIMIT = 12;
+    static constexpr std::size_t MIN_INPUT_SIZE = MATCH_FIND_LIMIT + 1;
+
+    static constexpr std::ptrdiff_t WILD_COPY_SIZE = 16;
+
+    static constexpr int HASH_LOG = 12;
+    static constexpr int SKIP_STRENGTH = 6;
+
+    // `0` is reserved for the empty entry
+    static constexpr std::uint32_t TABLE_BASE_INIT = 1;
+
+    static auto load_u32(const std::byte* src) -> std::uint32_t
+    {
+        std::uint32_t value;
+        std::memcpy(&value, src, sizeof(value));
+        return value;
+    }
+
+    static auto load_u64(const std::byte* src) -> std::uint64_t
+    {
+        std::uint64_t value;
+        std::memcpy(&value, src, sizeof(value));
+        return value;
+    }
+
+    static auto hash(const std::byte* src) -> std::size_t
+    {
+        return (load_u32(src) * 2654435761u) >> (32 - HASH_LOG);
+    }
+
+    /// @brief Number of the same bytes in `lhs` & `rhs`, where `lhs` can't go beyond `lhs_limit`.
+    static auto common_length(const std::byte* lhs, const std::byte* rhs, const std::byte* lhs_limit) -> std::size_t
+    {
+        const std::byte* const lhs_begin = lhs;
+
+        while (lhs_limit - lhs >= 8)
+        {
+            const std::uint64_t diff = load_u64(lhs) ^ load_u64(rhs);
+            if (diff != 0)
+            {
+                const int same_bits = (std::endian::native == std::endian::little) ? std::countr_zero(diff)
+                                                                                   : std::countl_zero(diff);
+                return static_cast<std::size_t>(lhs - lhs_begin) + same_bits / 8;
+            }
+
+            lhs += 8;
+            rhs += 8;
+        }
+        while (lhs < lhs_limit && *lhs == *rhs)
+        {
+            ++lhs;
+            ++rhs;
+        }
+
+        return static_cast<std::size_t>(lhs - lhs_begin);
+    }
+
+    /// @brief Write a sequence; If `match_len` is `0`, it's the last literals.
+    ///
+    /// @return End of the written sequence, or `nullptr` if `dest_end` is reached
+    static auto write_sequence(std::byte* dest, std::byte* dest_end, const std::byte* literals,
+                               std::size_t literal_len, std::size_t offset, std::size_t match_len) -> std::byte*
+    {
+        const std::size_t literal_extra = (literal_len >= 15) ? (literal_len - 15) / 255 + 1 : 0;
+        const std::size_t match_extra = (match_len >= MIN_MATCH + 15) ? (match_len - MIN_MATCH - 15) / 255 + 1 : 0;
+        const std::size_t required = 1 + literal_extra + literal_len + (match_len != 0 ? 2 + match_extra : 0);
+        if (required > static_cast<std::size_t>(dest_end - dest))
+            return nullptr;
+
+        std::byte* const token = dest++;
+
+        std::uint8_t token_value = static_cast<std::uint8_t>(std::min<std::size_t>(literal_len, 15) << 4);
+        if (literal_len >= 15)
+            dest = write_length(dest, literal_len - 15);
+
+        if (literal_len != 0) // `literals` can be `nullptr`
+            std::memcpy(dest, literals, literal_len);
+        dest += literal_len;
+
+        if (match_len != 0)
+        {
+            *dest++ = static_cast<std::byte>(offset & 0xFF);
+            *dest++ = static_cast<std::byte>(offset >> 8);
+
+            const std::size_t match_len_code = match_len - MIN_MATCH;
+            token_value |= static_cast<std::uint8_t>(std::min<std::size_t>(match_len_code, 15));
+            if (match_len_code >= 15)
+                dest = write_length(dest, match_len_code - 15);
+        }
+
+        *token = static_cast<std::byte>(token_value);
+        return dest;
+    }
+
+    static auto write_length(std::byte* dest, std::size_t length) -> std::byte*
+    {
+        for (; length >= 255; length -= 255)
+            *dest++ = std::byte(255);
+        *dest++ = static_cast<std::byte>(length);
+
+        return dest;
+    }
+
+    static bool try_read_length(const std::byte*& src, const std::byte* src_end, std::size_t& length)
+    {
+        std::uint8_t byte;
+        do
+        {
+            if (src == src_end)
+                return false;
+
+            byte = static_cast<std::uint8_t>(*src++);
+            length += byte;
+        } while (byte == 255);
+
+        return true;
+    }
+
+    /// @brief Copy the match, which might overlap with `dest`.
+    static void copy_match(std::byte* dest, std::size_t offset, std::size_t match_len)
+    {
+        const std::byte* match = dest - offset;
+
+        if (offset >= match_len)
+        {
+            std::memcpy(dest, match, match_len);
+            return;
+        }
+
+        // repeat the pattern, doubling the copied chunk each time
+        std::size_t copied = 0;
+        std::size_t chunk = offset;
+        while (copied < match_len)
+        {
+            const std::size_t len = std::min(chunk, match_len - copied);
+            std::memcpy(dest + copied, match, len);
+            copied += len;
+            chunk = copied + offset;
+        }
+    }
+
+private:
+    std::array<std::uint32_t, std::size_t(1) << HASH_LOG> _table;
+    std::uint32_t _base;
+};
+
+} // namespace nb
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace nb
+{
+
+/// @brief Fast LZ77-class block compressor, which uses the LZ4 block format.
+class BlockCompressor;
+
+} // namespace nb
@@ -0,0 +1,296 @@
+#pragma once
+
+#include "NetBuff/ChainedBuffer_fwd.hpp"
+
+#include "NetBuff/IntrusiveList.hpp"
+#include "NetBuff/ObjectPool.hpp"
+#include "NetBuff/SerializeInterface.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <utility>
+
+namespace nb
+{
+
+template <std::size_t SegmentSize>
+struct ChainedBufferSegment : public IntrusiveListNode
+{
+    // User-provided, to avoid zero-initializing `data` on `ObjectPool::construct()`
+    ChainedBufferSegment()
+    {
+    }
+
+    std::byte data[SegmentSize];
+};
+
+/// You MUST return all the segments (i.e. destroy or `clear()` all the `ChainedBuffer`s)
+/// before destroying its `SegmentPool`.
+template <std::size_t SegmentSize, typename Allocator>
+class ChainedBuffer : public SerializeInterface<ChainedBuffer<SegmentSize, Allocator>>
+{
+    static_assert(SegmentSize > 0);
+
+public:
+    using Segment = ChainedBufferSegment<SegmentSize>;
+    using SegmentPool = ObjectPool<Segment, true, Allocator>;
+
+private:
+    using Interface = SerializeInterface<ChainedBuffer>;
+
+public:
+    using typename Interface::DefaultStringLengthType;
+
+    using Interface::try_peek;
+    using Interface::try_read;
+    using Interface::try_write;
+
+public:
+    explicit ChainedBuffer(SegmentPool& pool) : _pool(&pool), _read_offset(0), _write_offset(0), _used(0)
+    {
+    }
+
+    ChainedBuffer(ChainedBuffer&& other) noexcept : _pool(other._pool), _read_offset(0), _write_offset(0), _used(0)
+    {
+        swap(other);
+    }
+
+    // Move and swap idiom
+    ChainedBuffer& operator=(ChainedBuffer other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ChainedBuffer(const ChainedBuffer&) = delete;
+
+public:
+    ~ChainedBuffer()
+    {
+        release_segments();
+    }
+
+public:
+    /// @brief Append `data` to the end, taking new segments from the pool as needed.
+    ///
+    /// If taking a segment throws, nothing happens to this buffer.
+    bool try_write(const void* data, std::size_t length)
+    {
+        auto* src = static_cast<const std::byte*>(data);
+
+        // take all the new segments before touching anything, as `construct()` may throw
+        const std::size_t tail_space = _segments.empty() ? 0 : SegmentSize - _write_offset;
+        IntrusiveList<Segment> new_segments;
+        if (length > tail_space)
+            take_segments(new_segments, (length - tail_space + SegmentSize - 1) / SegmentSize);
+
+        const std::size_t tail_len = std::min(length, tail_space);
+        if (tail_len > 0)
+        {
+            std::memcpy(_segments.back().data + _write_offset, src, tail_len);
+            _write_offset += tail_len;
+            src += tail_len;
+        }
+
+        std::size_t remain = length - tail_len;
+        for (Segment& segment : new_segments)
+        {
+            const std::size_t len = std::min(remain, SegmentSize);
+            std::memcpy(segment.data, src, len);
+
+            _write_offset = len;
+            src += len;
+            remain -= len;
+        }
+
+        _segments.splice(_segments.cend(), new_segments);
+        _used += length;
+
+        return true;
+    }
+
+    bool try_read(void* dest, std::size_t length)
+    {
+        const bool result = try_peek(dest, length);
+        if (result)
+            consume(length);
+
+        return result;
+    }
+
+    bool try_peek(void* dest, std::size_t length) const
+    {
+        if (length > used_space())
+        {
+            this->_fail = true;
+            return false;
+        }
+
+        auto* dst = static_cast<std::byte*>(dest);
+        std::size_t offset = _read_offset;
+
+        for (auto it = _segments.cbegin(); length > 0; ++it)
+        {
+            const std::size_t len = std::min(length, SegmentSize - offset);
+            std::memcpy(dst, it->data + offset, len);
+
+            offset = 0;
+            dst += len;
+            length -= len;
+        }
+
+        return true;
+    }
+
+    /// @brief Discard `length` bytes from the front, and return the fully read segments to the pool.
+    ///
+    /// No checks performed - Use with caution!
+    void consume(std::size_t length)
+    {
+        assert(length <= used_space());
+        _used -= length;
+
+        while (length > 0)
+        {
+            const std::size_t front_remain = SegmentSize - _read_offset;
+            if (length < front_remain)
+            {
+                _read_offset += length;
+                break;
+            }
+
+            length -= front_remain;
+            release_front_segment();
+            _read_offset = 0;
+        }
+
+        // reuse the positions from the start
+        if (_used == 0)
+            release_segments();
+    }
+
+public:
+    /// @brief Fill `segments` with the readable bytes in place, one span per chained segment.
+    ///
+    /// If there are more segments than `segments.size()`, only the front ones are filled;
+    /// `consume()` the bytes you've handled, and then `gather()` the rest.
+    ///
+    /// @return number of filled segments
+    auto gather(std::span<std::span<const std::byte>> segments) const -> std::size_t
+    {
+        std::size_t count = 0;
+        std::size_t remain = _used;
+        std::size_t offset = _read_offset;
+
+        for (auto it = _segments.cbegin(); remain > 0 && count < segments.size(); ++it, ++count)
+        {
+            const std::size_t len = std::min(remain, SegmentSize - offset);
+            segments[count] = std::span<const std::byte>(it->data + offset, len);
+
+            offset = 0;
+            remain -= len;
+        }
+
+        return count;
+    }
+
+public:
+    /// @brief Discard all data and return all the segments to the pool.
+    void clear()
+    {
+        release_segments();
+        this->_fail = false;
+    }
+
+    void swap(ChainedBuffer& other) noexcept
+    {
+        using std::swap;
+
+        swap(_pool, other._pool);
+        _segments.swap(other._segments);
+        swap(_read_offset, other._read_offset);
+        swap(_write_offset, other._write_offset);
+        swap(_used, other._used);
+        swap(this->_fail, other._fail);
+    }
+
+public:
+    bool empty() const
+    {
+        return _used == 0;
+    }
+
+    /// @brief Used space (i.e. How many bytes you can read before empty)
+    auto used_space() const -> std::size_t
+    {
+        return _used;
+    }
+
+    /// @brief Available space, which is unbounded. (Limited by the memory only)
+    auto available_space() const -> std::size_t
+    {
+        return std::numeric_limits<std::size_t>::max() - _used;
+    }
+
+    auto segment_count() const -> std::size_t
+    {
+        return _segments.size();
+    }
+
+    static constexpr auto segment_size() -> std::size_t
+    {
+        return SegmentSize;
+    }
+
+private:
+    /// @brief Take `count` segments from the pool, or none of them if it throws.
+    void take_segments(IntrusiveList<Segment>& segments, std::size_t count)
+    {
+        try
+        {
+            for (std::size_t idx = 0; idx < count; ++idx)
+                segments.push_back(_pool->construct());
+        }
+        catch (...)
+        {
+            while (!segments.empty())
+            {
+                Segment& segment = segments.front();
+                segments.pop_front();
+                _pool->destroy(segment);
+            }
+            throw;
+        }
+    }
+
+    void release_front_segment()
+    {
+        Segment& front = _segments.front();
+        _segments.pop_front();
+        _pool->destroy(front);
+    }
+
+    void release_segments()
+    {
+        while (!_segments.empty())
+            release_front_segment();
+
+        _read_offset = 0;
+        _write_offset = 0;
+        _used = 0;
+    }
+
+private:
+    SegmentPool* _pool;
+    IntrusiveList<Segment> _segments;
+
+    std::size_t _read_offset;  // in the front segment
+    std::size_t _write_offset; // in the back segment
+    std::size_t _used;
+};
+
+} // namespace nb
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace nb
+{
+
+/// @brief Unbounded byte stream made of fixed-size segments, which are taken from an `ObjectPool`.
+///
+/// Unlike `SerializeBuffer` or `RingByteBuffer`, growing it never copies the existing data.
+template <std::size_t SegmentSize = 4096, typename Allocator = std::allocator<std::byte>>
+class ChainedBuffer;
+
+} // namespace nb
@@ -0,0 +1,323 @@
+#pragma once
+
+#include "NetBuff/Crc32c_fwd.hpp"
+
+#include "NetBuff/RingByteBuffer.hpp"
+#include "NetBuff/SerializeBuffer.hpp"
+#include "NetBuff/SerializeInterface.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#if defined(__SSE4_2__) || (defined(_MSC_VER) && defined(__AVX__))
+#define NB_CRC32C_SSE42
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#define NB_CRC32C_ARM
+#include <arm_acle.h>
+#endif
+
+namespace nb
+{
+
+/// It uses the `crc32` instructions if available at compile time (SSE4.2 / ARMv8 CRC32),
+/// otherwise it falls back to the portable slicing-by-8 table.
+///
+/// The checksum is appended to the data as a little-endian `std::uint32_t`.
+class Crc32c
+{
+public:
+    static constexpr std::uint32_t POLYNOMIAL = 0x82F6'3B78; // reversed
+
+    static constexpr std::size_t CHECKSUM_SIZE = sizeof(std::uint32_t);
+
+public:
+    Crc32c() : _state(INITIAL_STATE)
+    {
+    }
+
+public:
+    void update(const void* data, std::size_t length)
+    {
+        _state = update_state(_state, static_cast<const std::byte*>(data), length);
+    }
+
+    void update(std::span<const std::byte> data)
+    {
+        update(data.data(), data.size());
+    }
+
+    void reset()
+    {
+        _state = INITIAL_STATE;
+    }
+
+    /// @brief CRC32C of the bytes updated so far.
+    auto value() const -> std::uint32_t
+    {
+        return ~_state;
+    }
+
+public:
+    static auto compute(const void* data, std::size_t length) -> std::uint32_t
+    {
+        return ~update_state(INITIAL_STATE, static_cast<const std::byte*>(data), length);
+    }
+
+    static auto compute(std::span<const std::byte> data) -> std::uint32_t
+    {
+        return compute(data.data(), data.size());
+    }
+
+    /// @brief Checks if the last `CHECKSUM_SIZE` bytes of `data` is the CRC32C of the bytes before them.
+    static bool verify(std::span<const std::byte> data)
+    {
+        if (data.size() < CHECKSUM_SIZE)
+            return false;
+
+        const auto payload = data.first(data.size() - CHECKSUM_SIZE);
+        return compute(payload) == load_checksum(data.data() + payload.size());
+    }
+
+    /// @brief Store `checksum` to `dest` as little-endian.
+    static void store_checksum(std::uint32_t checksum, std::byte* dest)
+    {
+        for (std::size_t idx = 0; idx < CHECKSUM_SIZE; ++idx)
+            dest[idx] = static_cast<std::byte>(checksum >> (8 * idx));
+    }
+
+    /// @brief Load a little-endian checksum from `src`.
+    static auto load_checksum(const std::byte* src) -> std::uint32_t
+    {
+        return load_u32(src);
+    }
+
+private:
+    static auto load_u32(const std::byte* src) -> std::uint32_t
+    {
+        return static_cast<std::uint32_t>(src[0]) | static_cast<std::uint32_t>(src[1]) << 8 |
+               static_cast<std::uint32_t>(src[2]) << 16 | static_cast<std::uint32_t>(src[3]) << 24;
+    }
+
+private:
+    static constexpr std::uint32_t INITIAL_STATE = 0xFFFF'FFFF;
+
+#if defined(NB_CRC32C_SSE42)
+    static auto update_state(std::uint32_t state, const std::byte* data, std::size_t length) -> std::uint32_t
+    {
+#if defined(_M_X64) || defined(__x86_64__)
+        std::uint64_t state_64 = state;
+        for (; length >= 8; data += 8, length -= 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+            state_64 = _mm_crc32_u64(state_64, word);
+        }
+        state = static_cast<std::uint32_t>(state_64);
+#endif
+        for (; length >= 4; data += 4, length -= 4)
+        {
+            std::uint32_t word;
+            std::memcpy(&word, data, sizeof(word));
+            state = _mm_crc32_u32(state, word);
+        }
+        for (; length > 0; ++data, --length)
+            state = _mm_crc32_u8(state, static_cast<std::uint8_t>(*data));
+
+        return state;
+    }
+#elif defined(NB_CRC32C_ARM)
+    static auto update_state(std::uint32_t state, const std::byte* data, std::size_t length) -> std::uint32_t
+    {
+        for (; length >= 8; data += 8, length -= 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+            state = __crc32cd(state, word);
+        }
+        for (; length > 0; ++data, --length)
+            state = __crc32cb(state, static_cast<std::uint8_t>(*data));
+
+        return state;
+    }
+#else
+    static auto update_state(std::uint32_t state, const std::byte* data, std::size_t length) -> std::uint32_t
+    {
+        // slicing-by-8
+        for (; length >= 8; data += 8, length -= 8)
+        {
+            const std::uint32_t low = state ^ load_u32(data);
+            const std::uint32_t high = load_u32(data + 4);
+
+            state = TABLE[7][low & 0xFF] ^ TABLE[6][(low >> 8) & 0xFF] ^ TABLE[5][(low >> 16) & 0xFF] ^
+                    TABLE[4][low >> 24] ^ TABLE[3][high & 0xFF] ^ TABLE[2][(high >> 8) & 0xFF] ^
+                    TABLE[1][(high >> 16) & 0xFF] ^ TABLE[0][high >> 24];
+        }
+        for (; length > 0; ++data, --length)
+            state = TABLE[0][(state ^ static_cast<std::uint8_t>(*data)) & 0xFF] ^ (state >> 8);
+
+        return state;
+    }
+
+    static constexpr auto make_table() -> std::array<std::array<std::uint32_t, 256>, 8>
+    {
+        std::array<std::array<std::uint32_t, 256>, 8> table{};
+
+        for (std::uint32_t byte = 0; byte < 256; ++byte)
+        {
+            std::uint32_t crc = byte;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc & 1) ? (crc >> 1) ^ POLYNOMIAL : (crc >> 1);
+
+            table[0][byte] = crc;
+        }
+        for (std::size_t slice = 1; slice < table.size(); ++slice)
+        {
+            for (std::size_t byte = 0; byte < 256; ++byte)
+            {
+                const std::uint32_t prev = table[slice - 1][byte];
+                table[slice][byte] = table[0][prev & 0xFF] ^ (prev >> 8);
+            }
+        }
+
+        return table;
+    }
+
+    static const std::array<std::array<std::uint32_t, 256>, 8> TABLE;
+#endif
+
+private:
+    std::uint32_t _state;
+};
+
+#if !defined(NB_CRC32C_SSE42) && !defined(NB_CRC32C_ARM)
+inline constexpr std::array<std::array<std::uint32_t, 256>, 8> Crc32c::TABLE = Crc32c::make_table();
+#endif
+
+/// `Buffer` can be either `SerializeBuffer`, `RingByteBuffer` or `SerializeWriter`.
+///
+/// The checksum is calculated from the source bytes right after they're copied, while they're still hot in cache,
+/// so there's no need for a second pass over the whole message.
+///
+/// e.g. `writer << a << b << c; writer.try_write_checksum();`
+template <typename Buffer>
+class Crc32cWriter : public SerializeInterface<Crc32cWriter<Buffer>>
+{
+private:
+    using Interface = SerializeInterface<Crc32cWriter>;
+
+public:
+    using typename Interface::DefaultStringLengthType;
+
+    using Interface::try_write;
+
+public:
+    explicit Crc32cWriter(Buffer& buffer) : _buffer(buffer)
+    {
+    }
+
+    Crc32cWriter(const Crc32cWriter&) = delete;
+    Crc32cWriter& operator=(const Crc32cWriter&) = delete;
+
+public:
+    bool try_write(const void* data, std::size_t length)
+    {
+        if (!_buffer.try_write(data, length))
+        {
+            this->_fail = true;
+            return false;
+        }
+
+        _crc.update(data, length);
+        return true;
+    }
+
+    /// @brief Append the checksum of the bytes written so far, and start a new checksum.
+    bool try_write_checksum()
+    {
+        std::array<std::byte, Crc32c::CHECKSUM_SIZE> checksum;
+        Crc32c::store_checksum(_crc.value(), checksum.data());
+
+        if (!_buffer.try_write(checksum.data(), checksum.size()))
+        {
+            this->_fail = true;
+            return false;
+        }
+
+        _crc.reset();
+        return true;
+    }
+
+public:
+    /// @brief Start a new checksum, and reset the fail bit.
+    void clear()
+    {
+        _crc.reset();
+        this->_fail = false;
+    }
+
+    /// @brief CRC32C of the bytes written so far.
+    auto checksum() const -> std::uint32_t
+    {
+        return _crc.value();
+    }
+
+    auto used_space() const -> std::size_t
+    {
+        return _buffer.used_space();
+    }
+
+    auto available_space() const -> std::size_t
+    {
+        return _buffer.available_space();
+    }
+
+private:
+    Buffer& _buffer;
+    Crc32c _crc;
+};
+
+/// @brief Checks if the `payload_length` bytes to read in `buf` is followed by its CRC32C.
+///
+/// Nothing is consumed; Read the payload and skip the checksum after verifying.
+template <typename ByteAllocator, std::size_t InlineCapacity>
+bool crc32c_verify(const SerializeBuffer<ByteAllocator, InlineCapacity>& buf, std::size_t payload_length)
+{
+    if (payload_length > buf.used_space() || Crc32c::CHECKSUM_SIZE > buf.used_space() - payload_length)
+        return false;
+
+    return Crc32c::verify({buf.data() + buf.read_pos(), payload_length + Crc32c::CHECKSUM_SIZE});
+}
+
+/// @brief Checks if the `payload_length` bytes to read in `ring` is followed by its CRC32C.
+///
+/// Nothing is consumed; Read the payload and skip the checksum after verifying.
+template <typename ByteAllocator>
+bool crc32c_verify(const RingByteBuffer<ByteAllocator>& ring, std::size_t payload_length)
+{
+    if (payload_length > ring.used_space() || Crc32c::CHECKSUM_SIZE > ring.used_space() - payload_length)
+        return false;
+
+    const std::size_t first_len = std::min(payload_length, ring.capacity() - ring.read_pos());
+
+    Crc32c crc;
+    crc.update(ring.data() + ring.read_pos(), first_len);
+    crc.update(ring.data(), payload_length - first_len);
+
+    // checksum itself might be wrapped
+    std::array<std::byte, Crc32c::CHECKSUM_SIZE> checksum;
+    std::size_t checksum_pos = (ring.read_pos() + payload_length) % ring.capacity();
+    for (auto& byte : checksum)
+    {
+        byte = ring.data()[checksum_pos];
+        checksum_pos = (checksum_pos + 1 == ring.capacity()) ? 0 : checksum_pos + 1;
+    }
+
+    return crc.value() == Crc32c::load_checksum(checksum.data());
+}
+
+} // namespace nb
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace nb
+{
+
+/// @brief Rolling CRC32C (Castagnoli) checksum.
+class Crc32c;
+
+/// @brief Writes to `Buffer`, and updates the CRC32C of the written bytes along the way.
+template <typename Buffer>
+class Crc32cWriter;
+
+} // namespace nb
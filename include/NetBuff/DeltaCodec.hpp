@@ -0,0 +1,261 @@
+#pragma once
+
+#include "NetBuff/DeltaCodec_fwd.hpp"
+
+#include "NetBuff/SerializeBuffer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
+namespace nb
+{
+
+/// The snapshot is split into the groups of 8 bytes, and the delta is encoded as below:
+/// - Size of the current snapshot (varint)
+/// - Group mask: 1 bit per group, which is set if any byte in the group is changed
+/// - For each changed group: byte mask (1 byte), followed by the changed bytes (i.e. new values)
+///
+/// If the current snapshot is longer than the baseline, the baseline is regarded to be zero-extended.
+///
+/// So, an unchanged snapshot costs only 1 bit per 8 bytes.
+class DeltaCodec
+{
+public:
+    static constexpr std::size_t GROUP_SIZE = 8;
+
+    using SizeType = std::uint32_t;
+
+public:
+    /// @brief Worst case encoded size of a snapshot of `size` bytes. (i.e. Every byte is changed)
+    static constexpr auto max_encoded_size(std::size_t size) -> std::size_t
+    {
+        const std::size_t groups = group_count(size);
+        return varint_max_size<SizeType>() + (groups + 7) / 8 + groups + size;
+    }
+
+    /// @brief Encode the delta from `baseline` to `current`, to the end of `dest`.
+    ///
+    /// @return `false` if `dest` doesn't have enough available space, or `current` is too large.
+    /// If failed, nothing happens to `dest`, i.e. nothing is written and its fail bit is left as is.
+    template <typename ByteAllocator, std::size_t InlineCapacity>
+    static bool try_encode(std::span<const std::byte> baseline, std::span<const std::byte> current,
+                           SerializeBuffer<ByteAllocator, InlineCapacity>& dest)
+    {
+        if (current.size() > std::numeric_limits<SizeType>::max())
+            return false;
+
+        const std::size_t prev_write_pos = dest.write_pos();
+
+        const std::size_t groups = group_count(current.size());
+        const std::size_t group_mask_size = (groups + 7) / 8;
+
+        // checked beforehand, as `try_write_varint()` would set the fail bit of `dest`
+        if (varint_size(static_cast<SizeType>(current.size())) + group_mask_size > dest.available_space())
+            return false;
+
+        [[maybe_unused]] const bool result = dest.try_write_varint(static_cast<SizeType>(current.size()));
+        assert(result);
+
+        // bytes beyond `current` are not encoded
+        baseline = baseline.first(std::min(baseline.size(), current.size()));
+
+        std::byte* const group_mask = dest.data() + dest.write_pos();
+        if (group_mask_size != 0) // `dest.data()` can be `nullptr`
+            std::memset(group_mask, 0, group_mask_size);
+        dest.move_write_pos(group_mask_size);
+
+        for (std::size_t group = 0; group < groups; ++group)
+        {
+            const std::size_t offset = group * GROUP_SIZE;
+            const std::uint64_t diff = load_group(current, offset) ^ load_group(baseline, offset);
+            if (diff == 0)
+                continue;
+
+            const std::uint8_t byte_mask = nonzero_byte_mask(diff);
+            const auto changed = static_cast<std::size_t>(std::popcount(byte_mask));
+            if (1 + changed > dest.available_space())
+            {
+                dest.move_write_pos(-static_cast<std::ptrdiff_t>(dest.write_pos() - prev_write_pos));
+                return false;
+            }
+
+            group_mask[group / 8] |= static_cast<std::byte>(1u << (group % 8));
+
+            std::byte* out = dest.data() + dest.write_pos();
+            *out++ = static_cast<std::byte>(byte_mask);
+            for (std::uint8_t bits = byte_mask; bits != 0; bits &= bits - 1)
+                *out++ = current[offset + std::countr_zero(bits)];
+
+            dest.move_write_pos(1 + changed);
+        }
+
+        return true;
+    }
+
+    /// @brief Encode the delta from the data to read in `baseline` to the data to read in `current`,
+    /// to the end of `dest`.
+    ///
+    /// Neither `baseline` nor `current` is read.
+    template <typename BaseAllocator, std::size_t BaseInline, typename CurAllocator, std::size_t CurInline,
+              typename DestAllocator, std::size_t DestInline>
+    static bool try_encode(const SerializeBuffer<BaseAllocator, BaseInline>& baseline,
+                           const SerializeBuffer<CurAllocator, CurInline>& current,
+                           SerializeBuffer<DestAllocator, DestInline>& dest)
+    {
+        return try_encode(std::span<const std::byte>(baseline.data() + baseline.read_pos(), baseline.used_space()),
+                          std::span<const std::byte>(current.data() + current.read_pos(), current.used_space()),
+                          dest);
+    }
+
+    /// @brief Read a delta from `delta`, and apply it to the data to read in `snapshot` in place.
+    ///
+    /// Only the changed bytes are written to `snapshot`.
+    /// If the snapshot grows, `snapshot` should have enough available space for it.
+    ///
+    /// @return `false` if the delta is malformed, or `snapshot` doesn't have enough available space.
+    /// If failed, nothing happens to both of them, i.e. nothing is read or written and their fail bits are left as is.
+    template <typename DeltaAllocator, std::size_t DeltaInline, typename SnapAllocator, std::size_t SnapInline>
+    static bool try_apply(SerializeBuffer<DeltaAllocator, DeltaInline>& delta,
+                          SerializeBuffer<SnapAllocator, SnapInline>& snapshot)
+    {
+        // decoded in place, as `try_read_varint()` would set the fail bit of `delta`
+        SizeType size;
+        const std::size_t size_field_size = decode_varint(delta.data() + delta.read_pos(), delta.used_space(), size);
+        if (size_field_size == 0)
+            return false;
+
+        const std::size_t baseline_size = snapshot.used_space();
+        if (size > baseline_size && size - baseline_size > snapshot.available_space())
+            return false;
+
+        const std::byte* const begin = delta.data() + delta.read_pos() + size_field_size;
+        std::size_t delta_size;
+        if (!try_validate(begin, delta.used_space() - size_field_size, size, delta_size))
+            return false;
+
+        // zero-extend or truncate
+        std::byte* const dest = snapshot.data() + snapshot.read_pos();
+        if (size > baseline_size)
+            std::memset(dest + baseline_size, 0, size - baseline_size);
+        snapshot.move_write_pos(static_cast<std::ptrdiff_t>(size) - static_cast<std::ptrdiff_t>(baseline_size));
+
+        // apply
+        const std::size_t groups = group_count(size);
+        const std::byte* const group_mask = begin;
+        const std::byte* in = begin + (groups + 7) / 8;
+
+        for (std::size_t group = 0; group < groups; ++group)
+        {
+            if ((static_cast<std::uint8_t>(group_mask[group / 8]) & (1u << (group % 8))) == 0)
+                continue;
+
+            const auto byte_mask = static_cast<std::uint8_t>(*in++);
+            for (std::uint8_t bits = byte_mask; bits != 0; bits &= bits - 1)
+                dest[group * GROUP_SIZE + std::countr_zero(bits)] = *in++;
+        }
+
+        delta.move_read_pos(size_field_size + delta_size);
+        return true;
+    }
+
+private:
+    static constexpr auto group_count(std::size_t size) -> std::size_t
+    {
+        return (size + GROUP_SIZE - 1) / GROUP_SIZE;
+    }
+
+    /// @brief Encoded size of `size` as a varint.
+    static constexpr auto varint_size(SizeType size) -> std::size_t
+    {
+        std::size_t varint_size = 1;
+        while (size >>= 7)
+            ++varint_size;
+
+        return varint_size;
+    }
+
+    /// @brief Load a group as little-endian, where the bytes beyond `data` are regarded to be zero.
+    static auto load_group(std::span<const std::byte> data, std::size_t offset) -> std::uint64_t
+    {
+        std::uint64_t value = 0;
+
+        if (offset + GROUP_SIZE <= data.size())
+        {
+            std::memcpy(&value, data.data() + offset, GROUP_SIZE);
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                std::uint64_t swapped = 0;
+                for (std::size_t idx = 0; idx < GROUP_SIZE; ++idx)
+                    swapped |= ((value >> (8 * idx)) & 0xFF) << (8 * (GROUP_SIZE - 1 - idx));
+                value = swapped;
+            }
+        }
+        else
+        {
+            for (std::size_t idx = offset; idx < data.size(); ++idx)
+                value |= static_cast<std::uint64_t>(data[idx]) << (8 * (idx - offset));
+        }
+
+        return value;
+    }
+
+    /// @brief Bit `i` is set if the byte `i` of `value` is non-zero. (SWAR)
+    static auto nonzero_byte_mask(std::uint64_t value) -> std::uint8_t
+    {
+        constexpr std::uint64_t LOW_7_BITS = 0x7F7F'7F7F'7F7F'7F7F;
+
+        // high bit of each byte is set if the byte is non-zero
+        const std::uint64_t high_bits = (((value & LOW_7_BITS) + LOW_7_BITS) | value) & ~LOW_7_BITS;
+
+        // gather the high bits to the top byte
+        return static_cast<std::uint8_t>(((high_bits >> 7) * 0x0102'0408'1020'4080) >> 56);
+    }
+
+    /// @brief Validate the delta of a snapshot of `size` bytes, after its size field.
+    ///
+    /// @param delta_size Size of the delta after its size field, if valid
+    static bool try_validate(const std::byte* delta, std::size_t delta_capacity, std::size_t size,
+                             std::size_t& delta_size)
+    {
+        const std::size_t groups = group_count(size);
+        const std::size_t group_mask_size = (groups + 7) / 8;
+        if (group_mask_size > delta_capacity)
+            return false;
+
+        // bits beyond the last group must be zero
+        if (groups % 8 != 0 && (static_cast<std::uint8_t>(delta[group_mask_size - 1]) >> (groups % 8)) != 0)
+            return false;
+
+        std::size_t pos = group_mask_size;
+        for (std::size_t group = 0; group < groups; ++group)
+        {
+            if ((static_cast<std::uint8_t>(delta[group / 8]) & (1u << (group % 8))) == 0)
+                continue;
+
+            if (pos >= delta_capacity)
+                return false;
+
+            const auto byte_mask = static_cast<std::uint8_t>(delta[pos]);
+
+            // bytes beyond the last byte must not be changed
+            const std::size_t group_size = std::min(GROUP_SIZE, size - group * GROUP_SIZE);
+            if (group_size < GROUP_SIZE && (byte_mask >> group_size) != 0)
+                return false;
+
+            pos += 1 + static_cast<std::size_t>(std::popcount(byte_mask));
+            if (pos > delta_capacity)
+                return false;
+        }
+
+        delta_size = pos;
+        return true;
+    }
+};
+
+} // namespace nb
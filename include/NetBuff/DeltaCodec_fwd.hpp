@@ -0,0 +1,9 @@
+#pragma once
+
+namespace nb
+{
+
+/// @brief Encodes the changed bytes between the successive snapshots of a serialized message.
+class DeltaCodec;
+
+} // namespace nb
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "NetBuff/FrameCodec_fwd.hpp"
+
+#include "NetBuff/RingByteBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace nb
+{
+
+/// Each complete frame is handed over as a contiguous view into the ring,
+/// and it's only copied to the internal linearize buffer when it wraps around the end of the ring.
+template <FrameLengthType LengthType, typename ByteAllocator>
+class FrameCodec : private ByteAllocator
+{
+    static_assert(std::is_same_v<std::byte, typename ByteAllocator::value_type>);
+
+public:
+    static constexpr std::size_t MAX_HEADER_SIZE = (LengthType == FrameLengthType::U16)   ? 2
+                                                   : (LengthType == FrameLengthType::U32) ? 4
+                                                                                          : 5;
+
+    static constexpr std::size_t MAX_PAYLOAD_SIZE =
+        (LengthType == FrameLengthType::U16) ? std::numeric_limits<std::uint16_t>::max()
+                                             : std::numeric_limits<std::uint32_t>::max();
+
+public:
+    /// @param max_payload_size Frames larger than this are treated as malformed.
+    /// (The linearize buffer is allocated with this size)
+    FrameCodec(std::size_t max_payload_size)
+        : _max_payload_size(std::min(max_payload_size, MAX_PAYLOAD_SIZE)),
+          _linear_buffer(_max_payload_size == 0 ? nullptr : this->allocate(_max_payload_size)), _bytes_needed(0),
+          _fail(false)
+    {
+    }
+
+    FrameCodec(const FrameCodec&) = delete;
+    FrameCodec& operator=(const FrameCodec&) = delete;
+
+    FrameCodec(FrameCodec&&) = delete;
+    FrameCodec& operator=(FrameCodec&&) = delete;
+
+public:
+    ~FrameCodec()
+    {
+        if (_linear_buffer)
+            this->deallocate(_linear_buffer, _max_payload_size);
+    }
+
+public:
+    /// @brief Check if a malformed frame was found. (i.e. Too large or invalid length)
+    ///
+    /// Fail bit is never cleared unless `clear()` is called, and nothing is decoded while it's set.
+    bool fail() const
+    {
+        return _fail;
+    }
+
+    /// @brief How many more bytes are required to complete the next frame, as of the last `decode()`.
+    ///
+    /// If the length of the next frame is not known yet, this only counts up to the end of its length.
+    auto bytes_needed() const -> std::size_t
+    {
+        return _bytes_needed;
+    }
+
+    void clear()
+    {
+        _bytes_needed = 0;
+        _fail = false;
+    }
+
+public:
+    /// @brief Extract all the complete frames in `ring`, and call `on_frame` for each of them.
+    ///
+    /// `on_frame` is called with `std::span<const std::byte>` of the payload,
+    /// which is only valid until `on_frame` returns, as it's consumed from the `ring` right after.
+    ///
+    /// @return number of frames extracted
+    template <typename RingAllocator, typename OnFrame>
+    auto decode(RingByteBuffer<RingAllocator>& ring, OnFrame&& on_frame) -> std::size_t
+    {
+        std::size_t frames = 0;
+
+        while (!_fail)
+        {
+            const std::size_t used = ring.used_space();
+
+            std::size_t header_size, payload_size;
+            if (!try_peek_header(ring, header_size, payload_size))
+                break;
+
+            if (header_size + payload_size > used)
+            {
+                _bytes_needed = header_size + payload_size - used;
+                return frames;
+            }
+
+            // skip the header
+            ring.move_read_pos(header_size);
+
+            // 1-phase: view into the `ring`
+            if (payload_size <= ring.capacity() - ring.read_pos())
+            {
+                on_frame(std::span<const std::byte>(ring.data() + ring.read_pos(), payload_size));
+            }
+            // 2-phase: linearize it
+            else
+            {
+                [[maybe_unused]] const bool result = ring.try_peek(_linear_buffer, payload_size);
+                assert(result);
+
+                on_frame(std::span<const std::byte>(_linear_buffer, payload_size));
+            }
+
+            ring.move_read_pos(payload_size);
+            ++frames;
+        }
+
+        return frames;
+    }
+
+    /// @brief Write a frame of `payload` to `ring`.
+    ///
+    /// @return `false` if there's not enough space in `ring`, or `payload` is too large.
+    template <typename RingAllocator>
+    bool try_write_frame(RingByteBuffer<RingAllocator>& ring, std::span<const std::byte> payload) const
+    {
+        if (payload.size() > _max_payload_size)
+            return false;
+
+        std::array<std::byte, MAX_HEADER_SIZE> header;
+        const std::size_t header_size = encode_header(payload.size(), header.data());
+
+        if (header_size + payload.size() > ring.available_space())
+            return false;
+
+        [[maybe_unused]] bool result = ring.try_write(header.data(), header_size);
+        assert(result);
+        result = ring.try_write(payload.data(), payload.size());
+        assert(result);
+
+        return true;
+    }
+
+public:
+    /// @brief Encode the length header of a frame to `dest`, which should have `MAX_HEADER_SIZE` bytes.
+    ///
+    /// @return size of the header
+    static auto encode_header(std::size_t payload_size, std::byte* dest) -> std::size_t
+    {
+        assert(payload_size <= MAX_PAYLOAD_SIZE);
+
+        if constexpr (LengthType == FrameLengthType::VARINT)
+        {
+            std::size_t idx = 0;
+            for (; payload_size >= 0x80; payload_size >>= 7)
+                dest[idx++] = static_cast<std::byte>((payload_size & 0x7F) | 0x80);
+            dest[idx++] = static_cast<std::byte>(payload_size);
+
+            return idx;
+        }
+        else
+        {
+            for (std::size_t idx = 0; idx < MAX_HEADER_SIZE; ++idx)
+                dest[idx] = static_cast<std::byte>(payload_size >> (8 * idx));
+
+            return MAX_HEADER_SIZE;
+        }
+    }
+
+private:
+    /// @return whether the header is complete (Sets `_bytes_needed` or `_fail` otherwise)
+    template <typename RingAllocator>
+    bool try_peek_header(const RingByteBuffer<RingAllocator>& ring, std::size_t& header_size,
+                         std::size_t& payload_size)
+    {
+        const std::size_t used = ring.used_space();
+
+        std::array<std::byte, MAX_HEADER_SIZE> header;
+        const std::size_t peek_size = std::min(used, MAX_HEADER_SIZE);
+        [[maybe_unused]] const bool result = ring.try_peek(header.data(), peek_size);
+        assert(result);
+
+        if constexpr (LengthType == FrameLengthType::VARINT)
+        {
+            payload_size = 0;
+            for (header_size = 0; header_size < peek_size; ++header_size)
+            {
+                const auto byte = static_cast<std::size_t>(header[header_size]);
+
+                // last byte has only 4 bits that fit in 32 bits, and no continuation bit
+                if (header_size == MAX_HEADER_SIZE - 1 && byte > 0x0F)
+                {
+                    _fail = true;
+                    return false;
+                }
+
+                payload_size |= (byte & 0x7F) << (7 * header_size);
+
+                if (!(byte & 0x80))
+                    break;
+            }
+
+            if (header_size == peek_size)
+            {
+                _bytes_needed = 1;
+                return false;
+            }
+
+            ++header_size; // include the last byte
+        }
+        else
+        {
+            if (peek_size < MAX_HEADER_SIZE)
+            {
+                _bytes_needed = MAX_HEADER_SIZE - peek_size;
+                return false;
+            }
+
+            header_size = MAX_HEADER_SIZE;
+            payload_size = 0;
+            for (std::size_t idx = 0; idx < MAX_HEADER_SIZE; ++idx)
+                payload_size |= static_cast<std::size_t>(header[idx]) << (8 * idx);
+        }
+
+        if (payload_size > _max_payload_size)
+        {
+            _fail = true;
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    std::size_t _max_payload_size;
+    std::byte* _linear_buffer;
+
+    std::size_t _bytes_needed;
+    bool _fail;
+};
+
+} // namespace nb
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nb
+{
+
+/// @brief How the payload length of a frame is encoded in front of it. (little-endian)
+enum class FrameLengthType : std::uint8_t
+{
+    U16,
+    U32,
+    VARINT, // LEB128, up to 32-bit
+};
+
+/// @brief Length-prefixed frame encoder & decoder over `RingByteBuffer`.
+template <FrameLengthType LengthType, typename ByteAllocator = std::allocator<std::byte>>
+class FrameCodec;
+
+} // namespace nb
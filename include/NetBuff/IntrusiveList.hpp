@@ -2,26 +2,245 @@
 
 #include "NetBuff/IntrusiveList_fwd.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iterator>
+#include <new>
 #include <utility>
 
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
 namespace nb
 {
 
 struct IntrusiveListNode
 {
 private:
-    template <typename T>
-        requires std::is_base_of_v<IntrusiveListNode, T>
+    template <typename T, bool ConstantTimeSize, typename Hook>
+        requires IntrusiveListHookOf<Hook, T>
     friend class IntrusiveList;
 
+    template <typename>
+    friend struct AutoUnlinkIntrusiveListNode;
+
     IntrusiveListNode* prev;
     IntrusiveListNode* next;
 };
 
-template <typename T>
-    requires std::is_base_of_v<IntrusiveListNode, T>
+template <typename Tag>
+struct TaggedIntrusiveListNode
+{
+private:
+    template <typename>
+    friend struct IntrusiveListBaseHook;
+
+    IntrusiveListNode _node;
+};
+
+template <typename Tag>
+struct AutoUnlinkIntrusiveListNode
+{
+public:
+    AutoUnlinkIntrusiveListNode() noexcept
+    {
+        _node.prev = nullptr;
+        _node.next = nullptr;
+    }
+
+    // The copy is another object, which is not linked anywhere
+    AutoUnlinkIntrusiveListNode(const AutoUnlinkIntrusiveListNode&) noexcept : AutoUnlinkIntrusiveListNode()
+    {
+    }
+
+    // Keeps its own links
+    AutoUnlinkIntrusiveListNode& operator=(const AutoUnlinkIntrusiveListNode&) noexcept
+    {
+        return *this;
+    }
+
+    ~AutoUnlinkIntrusiveListNode()
+    {
+        unlink();
+    }
+
+public:
+    bool is_linked() const noexcept
+    {
+        return _node.next != nullptr;
+    }
+
+    /// @brief Unlinks itself from the list it's linked to in O(1), or does nothing if it's not linked.
+    void unlink() noexcept
+    {
+        if (!is_linked())
+            return;
+
+        _node.prev->next = _node.next;
+        _node.next->prev = _node.prev;
+
+        _node.prev = nullptr;
+        _node.next = nullptr;
+    }
+
+private:
+    template <typename>
+    friend struct IntrusiveListAutoUnlinkHook;
+
+    template <auto>
+    friend struct IntrusiveListMemberHook;
+
+    IntrusiveListNode _node;
+};
+
+template <typename Tag>
+struct IntrusiveListBaseHook
+{
+private:
+    using Node = std::conditional_t<std::is_void_v<Tag>, IntrusiveListNode, TaggedIntrusiveListNode<Tag>>;
+
+    // `TaggedIntrusiveListNode<Tag>` is a standard-layout class, so `_node` is at its address
+    static_assert(std::is_standard_layout_v<TaggedIntrusiveListNode<Tag>>);
+
+public:
+    template <typename T>
+        requires std::is_base_of_v<Node, T>
+    static auto to_node(T& obj) noexcept -> IntrusiveListNode&
+    {
+        if constexpr (std::is_void_v<Tag>)
+            return static_cast<IntrusiveListNode&>(obj);
+        else
+            return static_cast<Node&>(obj)._node;
+    }
+
+    template <typename T>
+        requires std::is_base_of_v<Node, T>
+    static auto to_node(const T& obj) noexcept -> const IntrusiveListNode&
+    {
+        return to_node(const_cast<T&>(obj));
+    }
+
+    template <typename T>
+        requires std::is_base_of_v<Node, T>
+    static auto from_node(IntrusiveListNode& node) noexcept -> T&
+    {
+        if constexpr (std::is_void_v<Tag>)
+            return static_cast<T&>(node);
+        else
+            return static_cast<T&>(*reinterpret_cast<Node*>(&node));
+    }
+};
+
+template <typename Tag>
+struct IntrusiveListAutoUnlinkHook
+{
+private:
+    using Node = AutoUnlinkIntrusiveListNode<Tag>;
+
+    static_assert(std::is_standard_layout_v<Node>);
+
+public:
+    static constexpr bool AUTO_UNLINK = true;
+
+    template <typename T>
+        requires std::is_base_of_v<Node, T>
+    static auto to_node(T& obj) noexcept -> IntrusiveListNode&
+    {
+        return static_cast<Node&>(obj)._node;
+    }
+
+    template <typename T>
+        requires std::is_base_of_v<Node, T>
+    static auto to_node(const T& obj) noexcept -> const IntrusiveListNode&
+    {
+        return to_node(const_cast<T&>(obj));
+    }
+
+    template <typename T>
+        requires std::is_base_of_v<Node, T>
+    static auto from_node(IntrusiveListNode& node) noexcept -> T&
+    {
+        return static_cast<T&>(*reinterpret_cast<Node*>(&node));
+    }
+};
+
+/// @brief Offset of a data member in standard-layout `T`, like `offsetof`, but from a pointer to the member.
+///
+/// It's read from the representation of the pointer, which is the offset on both the Itanium & MSVC ABIs,
+/// so that no `T` object is needed.
+template <typename T, typename Member>
+    requires std::is_standard_layout_v<T>
+auto member_offset_of(Member T::*member) noexcept -> std::ptrdiff_t
+{
+    if constexpr (sizeof(member) == sizeof(std::int32_t))
+        return std::bit_cast<std::int32_t>(member);
+    else
+        return std::bit_cast<std::ptrdiff_t>(member);
+}
+
+template <typename T, IntrusiveListNode T::*Member>
+struct IntrusiveListMemberHook<Member>
+{
+    static auto to_node(T& obj) noexcept -> IntrusiveListNode&
+    {
+        return obj.*Member;
+    }
+
+    static auto to_node(const T& obj) noexcept -> const IntrusiveListNode&
+    {
+        return obj.*Member;
+    }
+
+    template <typename U>
+        requires std::is_same_v<T, U>
+    static auto from_node(IntrusiveListNode& node) noexcept -> T&
+    {
+        return *reinterpret_cast<T*>(reinterpret_cast<std::byte*>(&node) - MEMBER_OFFSET);
+    }
+
+private:
+    static_assert(std::is_standard_layout_v<T>, "`T` must be standard-layout to be located by the offset of `Member`");
+
+    static inline const std::ptrdiff_t MEMBER_OFFSET = member_offset_of(Member);
+};
+
+template <typename T, typename Tag, AutoUnlinkIntrusiveListNode<Tag> T::*Member>
+struct IntrusiveListMemberHook<Member>
+{
+    static constexpr bool AUTO_UNLINK = true;
+
+    static auto to_node(T& obj) noexcept -> IntrusiveListNode&
+    {
+        return (obj.*Member)._node;
+    }
+
+    static auto to_node(const T& obj) noexcept -> const IntrusiveListNode&
+    {
+        return (obj.*Member)._node;
+    }
+
+    template <typename U>
+        requires std::is_same_v<T, U>
+    static auto from_node(IntrusiveListNode& node) noexcept -> T&
+    {
+        // `AutoUnlinkIntrusiveListNode<Tag>` is a standard-layout class, so `_node` is at its address
+        return *reinterpret_cast<T*>(reinterpret_cast<std::byte*>(&node) - MEMBER_OFFSET);
+    }
+
+private:
+    static_assert(std::is_standard_layout_v<T>, "`T` must be standard-layout to be located by the offset of `Member`");
+
+    static inline const std::ptrdiff_t MEMBER_OFFSET = member_offset_of(Member);
+};
+
+template <typename T, bool ConstantTimeSize, typename Hook>
+    requires IntrusiveListHookOf<Hook, T>
 class IntrusiveList
 {
 public:
@@ -33,6 +252,15 @@ public:
     using pointer = T*;
     using const_pointer = const T*;
 
+    /// @brief Whether the nodes know if they're linked, and unlink themselves on destruction.
+    static constexpr bool AUTO_UNLINK = requires { requires Hook::AUTO_UNLINK; };
+
+    static_assert(!(AUTO_UNLINK && ConstantTimeSize),
+                  "Auto-unlinking nodes can't update the size, so `ConstantTimeSize` should be `false`");
+
+    /// @brief How many nodes ahead `for_each_prefetch()` and `remove_if_prefetch()` prefetch by default.
+    static constexpr std::size_t DEFAULT_PREFETCH_DISTANCE = 4;
+
 public:
     class iterator
     {
@@ -57,12 +285,12 @@ public:
     public:
         auto operator*() const -> reference
         {
-            return static_cast<reference>(*_node);
+            return Hook::template from_node<T>(*_node);
         }
 
         auto operator->() const -> pointer
         {
-            return static_cast<pointer>(_node);
+            return &Hook::template from_node<T>(*_node);
         }
 
         bool operator==(const iterator& other) const
@@ -124,12 +352,12 @@ public:
     public:
         auto operator*() const -> reference
         {
-            return static_cast<reference>(*_node);
+            return Hook::template from_node<T>(*_node);
         }
 
         auto operator->() const -> pointer
         {
-            return static_cast<pointer>(_node);
+            return &Hook::template from_node<T>(*_node);
         }
 
         bool operator==(const const_iterator& other) const
@@ -173,7 +401,7 @@ public:
 public:
     IntrusiveList()
     {
-        clear();
+        reset_links();
     }
 
     IntrusiveList(const IntrusiveList&) = delete;
@@ -190,6 +418,15 @@ public:
         return *this;
     }
 
+    ~IntrusiveList() = default;
+
+    // Auto-unlinking nodes outliving the list must not unlink from it later
+    ~IntrusiveList()
+        requires AUTO_UNLINK
+    {
+        clear();
+    }
+
 public: // Element access
     auto front() -> reference
     {
@@ -275,31 +512,44 @@ public: // Iterators
 public: // Capacity
     bool empty() const noexcept
     {
-        return _size == 0;
+        return _head.next == &_tail;
     }
 
+    /// @brief Number of elements, which is O(n) if `ConstantTimeSize` is `false`.
     auto size() const noexcept -> size_type
     {
-        return _size;
+        if constexpr (ConstantTimeSize)
+            return _size;
+        else
+            return static_cast<size_type>(std::distance(cbegin(), cend()));
     }
 
 public: // Modifiers
+    /// @brief Removes all elements, which is O(n) if the hook is auto-unlink, as each node is marked unlinked.
     void clear() noexcept
     {
-        _size = 0;
-        _head.next = &_tail;
-        _tail.prev = &_head;
+        if constexpr (AUTO_UNLINK)
+        {
+            for (IntrusiveListNode* node = _head.next; node != &_tail;)
+            {
+                IntrusiveListNode* next = node->next;
+                mark_unlinked(*node);
+                node = next;
+            }
+        }
+
+        reset_links();
     }
 
     auto insert(const_iterator pos, reference value) -> iterator
     {
-        ++_size;
-        return link_new_node(pos, value);
+        add_size(1);
+        return link_new_node(pos, Hook::to_node(value));
     }
 
     auto insert(const_reference pos, reference value) -> iterator
     {
-        return insert(const_iterator(&pos), value);
+        return insert(const_iterator(&Hook::to_node(pos)), value);
     }
 
     template <typename InputIt>
@@ -312,7 +562,7 @@ public: // Modifiers
     template <typename InputIt>
     void insert(const_reference pos, InputIt first, InputIt last)
     {
-        insert(const_iterator(&pos), first, last);
+        insert(const_iterator(&Hook::to_node(pos)), first, last);
     }
 
     auto erase(const_iterator pos) -> iterator
@@ -323,7 +573,10 @@ public: // Modifiers
         del_node->prev->next = del_node->next;
         del_node->next->prev = del_node->prev;
 
-        --_size;
+        if constexpr (AUTO_UNLINK)
+            mark_unlinked(*del_node);
+
+        sub_size(1);
 
         return iterator(ret_node);
     }
@@ -331,7 +584,7 @@ public: // Modifiers
     /// @brief Erases the specified element in O(1).
     auto erase(reference pos) -> iterator
     {
-        return erase(const_iterator(&pos));
+        return erase(const_iterator(&Hook::to_node(pos)));
     }
 
     auto erase(const_iterator first, const_iterator last) -> iterator
@@ -350,10 +603,22 @@ public: // Modifiers
         del_first->prev->next = del_last;
         del_last->prev = del_first->prev;
 
-        while (del_first != del_last)
+        if constexpr (ConstantTimeSize)
+        {
+            while (del_first != del_last)
+            {
+                del_first = del_first->next;
+                --_size;
+            }
+        }
+        else if constexpr (AUTO_UNLINK)
         {
-            del_first = del_first->next;
-            --_size;
+            while (del_first != del_last)
+            {
+                IntrusiveListNode* next = del_first->next;
+                mark_unlinked(*del_first);
+                del_first = next;
+            }
         }
 
         return iterator(last._node);
@@ -383,11 +648,13 @@ public: // Modifiers
     {
         using std::swap; // ADL
 
-        // 1. swap the size first
+        const bool had_nodes = !empty();
+        const bool other_had_nodes = !other.empty();
+
         swap(_size, other._size);
 
-        // 2. connect to other nodes if those are not empty
-        if (!empty() && !other.empty())
+        // connect to other nodes if those are not empty
+        if (had_nodes && other_had_nodes)
         {
             swap(_head.next, other._head.next);
             swap(_tail.prev, other._tail.prev);
@@ -398,7 +665,7 @@ public: // Modifiers
             other._head.next->prev = &other._head;
             other._tail.prev->next = &other._tail;
         }
-        else if (!empty())
+        else if (other_had_nodes)
         {
             _head.next = other._head.next;
             _tail.prev = other._tail.prev;
@@ -410,7 +677,7 @@ public: // Modifiers
             other._head.next = &other._tail;
             other._tail.prev = &other._head;
         }
-        else if (!other.empty())
+        else if (had_nodes)
         {
             other._head.next = _head.next;
             other._tail.prev = _tail.prev;
@@ -425,31 +692,340 @@ public: // Modifiers
     }
 
 public: // Operations
+    /// @brief Moves all elements of `other` before `pos` in O(1).
+    void splice(const_iterator pos, IntrusiveList& other)
+    {
+        assert(&other != this);
+
+        if (other.empty())
+            return;
+
+        add_size(other._size);
+        relink_range(pos._node, other._head.next, other._tail.prev);
+        other.reset_links();
+    }
+
+    void splice(const_iterator pos, IntrusiveList&& other)
+    {
+        splice(pos, other);
+    }
+
+    /// @brief Moves the element `it` of `other` before `pos` in O(1).
+    ///
+    /// `other` can be `*this`.
+    void splice(const_iterator pos, IntrusiveList& other, const_iterator it)
+    {
+        // already there
+        if (pos == it || pos._node == it._node->next)
+            return;
+
+        other.sub_size(1);
+        add_size(1);
+        relink_range(pos._node, it._node, it._node);
+    }
+
+    void splice(const_iterator pos, IntrusiveList&& other, const_iterator it)
+    {
+        splice(pos, other, it);
+    }
+
+    /// @brief Moves the elements `[first, last)` of `other` before `pos`.
+    ///
+    /// This is O(1) if `ConstantTimeSize` is `false` or `other` is `*this`, otherwise O(n) to count the elements.
+    /// `pos` should not be in `[first, last)`.
+    void splice(const_iterator pos, IntrusiveList& other, const_iterator first, const_iterator last)
+    {
+        if constexpr (ConstantTimeSize)
+        {
+            if (&other != this)
+            {
+                splice(pos, other, first, last, static_cast<size_type>(std::distance(first, last)));
+                return;
+            }
+        }
+
+        if (first != last)
+            relink_range(pos._node, first._node, last._node->prev);
+    }
+
+    void splice(const_iterator pos, IntrusiveList&& other, const_iterator first, const_iterator last)
+    {
+        splice(pos, other, first, last);
+    }
+
+    /// @brief Moves the `count` elements `[first, last)` of `other` before `pos` in O(1).
+    ///
+    /// `count` should be `std::distance(first, last)`, which you often know without walking the range.
+    void splice(const_iterator pos, IntrusiveList& other, const_iterator first, const_iterator last, size_type count)
+    {
+        assert(static_cast<size_type>(std::distance(first, last)) == count);
+
+        if (first == last)
+            return;
+
+        other.sub_size(count);
+        add_size(count);
+        relink_range(pos._node, first._node, last._node->prev);
+    }
+
+    /// @brief Moves the elements `[pos, end())` to a new list.
+    ///
+    /// This is O(1) if `ConstantTimeSize` is `false`, otherwise O(n) to count the elements.
+    auto split(const_iterator pos) -> IntrusiveList
+    {
+        IntrusiveList result;
+        result.splice(result.cend(), *this, pos, cend());
+        return result;
+    }
+
     /// @brief Removes all elements that's equal to `value`.
     ///
     /// If you want to only remove the specified element from the list, use `erase()` instead.
+    ///
+    /// @return number of removed elements
     auto remove(const_reference value) -> size_type
     {
         return remove_if([&value](const_reference val) { return val == value; });
     }
 
+    /// @brief Removes all elements that satisfy `pred`.
+    ///
+    /// @return number of removed elements
     template <typename UnaryPredicate>
     auto remove_if(UnaryPredicate pred) -> size_type
     {
+        size_type removed = 0;
         for (auto it = cbegin(); it != cend();)
         {
             if (pred(*it))
+            {
                 it = erase(it);
+                ++removed;
+            }
             else
                 ++it;
         }
 
-        return _size;
+        return removed;
+    }
+
+    /// @brief Removes all elements that satisfy `pred`, while prefetching the element `Distance` nodes ahead.
+    ///
+    /// @return number of removed elements
+    template <std::size_t Distance = DEFAULT_PREFETCH_DISTANCE, typename UnaryPredicate>
+    auto remove_if_prefetch(UnaryPredicate pred) -> size_type
+    {
+        size_type removed = 0;
+        walk_prefetch<Distance>([this, &pred, &removed](IntrusiveListNode* node) {
+            if (pred(std::as_const(Hook::template from_node<T>(*node))))
+            {
+                erase(const_iterator(node));
+                ++removed;
+            }
+        });
+
+        return removed;
+    }
+
+    /// @brief Calls `func` with each element, while prefetching the element `Distance` nodes ahead.
+    ///
+    /// The lookahead walk overlaps the `next` loads with the work of `func`, instead of stalling on each of them.
+    /// `func` may erase the element it's given, but no other element.
+    template <std::size_t Distance = DEFAULT_PREFETCH_DISTANCE, typename Func>
+    void for_each_prefetch(Func func)
+    {
+        walk_prefetch<Distance>([&func](IntrusiveListNode* node) { func(Hook::template from_node<T>(*node)); });
+    }
+
+    template <std::size_t Distance = DEFAULT_PREFETCH_DISTANCE, typename Func>
+    void for_each_prefetch(Func func) const
+    {
+        const_cast<IntrusiveList*>(this)->template walk_prefetch<Distance>(
+            [&func](IntrusiveListNode* node) { func(std::as_const(Hook::template from_node<T>(*node))); });
+    }
+
+    /// @brief Sorts the elements with `comp` in O(n log n), by relinking the nodes.
+    ///
+    /// This is a stable bottom-up merge sort, which doesn't allocate.
+    template <typename Compare = std::less<>>
+    void sort(Compare comp = Compare())
+    {
+        if (_head.next == _tail.prev)
+            return;
+
+        // `runs[i]` is either `nullptr` or a sorted run of `2^i` nodes, linked with only `next` and null-terminated.
+        // Higher runs hold earlier nodes, so merging them in front keeps the sort stable.
+        std::array<IntrusiveListNode*, sizeof(size_type) * 8> runs{};
+        std::size_t run_count = 0;
+
+        _tail.prev->next = nullptr;
+        for (IntrusiveListNode* node = _head.next; node;)
+        {
+            IntrusiveListNode* run = node;
+            node = node->next;
+            run->next = nullptr;
+
+            std::size_t idx = 0;
+            for (; idx < run_count && runs[idx]; ++idx)
+            {
+                run = merge_runs(runs[idx], run, comp);
+                runs[idx] = nullptr;
+            }
+            if (idx == run_count)
+                ++run_count;
+            runs[idx] = run;
+        }
+
+        IntrusiveListNode* sorted = nullptr;
+        for (std::size_t idx = 0; idx < run_count; ++idx)
+        {
+            if (runs[idx])
+                sorted = sorted ? merge_runs(runs[idx], sorted, comp) : runs[idx];
+        }
+
+        // restore `prev` links, and reconnect to head & tail
+        IntrusiveListNode* prev = &_head;
+        for (IntrusiveListNode* node = sorted; node; node = node->next)
+        {
+            node->prev = prev;
+            prev->next = node;
+            prev = node;
+        }
+        prev->next = &_tail;
+        _tail.prev = prev;
+    }
+
+    /// @brief Reorders the elements to match their memory order, which makes the traversal sequential.
+    ///
+    /// Useful after the elements churned in a pool, which leaves the links jumping all over it.
+    void sort_by_address()
+    {
+        sort([](const_reference lhs, const_reference rhs) { return std::less<const T*>{}(&lhs, &rhs); });
     }
 
 private:
+    static constexpr std::size_t PREFETCH_LINE_SIZE = std::hardware_constructive_interference_size;
+    static constexpr std::size_t PREFETCH_MAX_LINES = 4;
+
+    /// @brief Hints the CPU to bring the cache lines of the element into the cache.
+    static void prefetch(IntrusiveListNode* node) noexcept
+    {
+        const auto* addr = reinterpret_cast<const char*>(&Hook::template from_node<T>(*node));
+        constexpr std::size_t lines = std::min((sizeof(T) + PREFETCH_LINE_SIZE - 1) / PREFETCH_LINE_SIZE, //
+                                               PREFETCH_MAX_LINES);
+
+        for (std::size_t line = 0; line < lines; ++line)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(addr + line * PREFETCH_LINE_SIZE);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_prefetch(addr + line * PREFETCH_LINE_SIZE, _MM_HINT_T0);
+#else
+            (void)addr;
+#endif
+        }
+    }
+
+    /// @brief Calls `func` with each node, while keeping a lookahead `Distance` nodes ahead and prefetching it.
+    ///
+    /// `func` may unlink the node it's given, as the next node is loaded before calling it.
+    template <std::size_t Distance, typename NodeFunc>
+    void walk_prefetch(NodeFunc func)
+    {
+        static_assert(Distance > 0, "Prefetch distance should be positive");
+
+        // `ahead` is the last prefetched node, so loading its `next` has had time to complete
+        IntrusiveListNode* ahead = &_head;
+        for (std::size_t count = 0; count < Distance && ahead->next != &_tail; ++count)
+        {
+            ahead = ahead->next;
+            prefetch(ahead);
+        }
+
+        for (IntrusiveListNode* node = _head.next; node != &_tail;)
+        {
+            // `ahead` is past `node` unless it's the last node, so `func` can't unlink it before it's used
+            if (ahead->next != &_tail)
+            {
+                ahead = ahead->next;
+                prefetch(ahead);
+            }
+
+            IntrusiveListNode* next = node->next;
+            func(node);
+            node = next;
+        }
+    }
+
+    /// @brief Merges the sorted runs `first` and `second`, taking from `first` on ties.
+    template <typename Compare>
+    static auto merge_runs(IntrusiveListNode* first, IntrusiveListNode* second, Compare& comp) -> IntrusiveListNode*
+    {
+        IntrusiveListNode dummy;
+        IntrusiveListNode* last = &dummy;
+
+        while (first && second)
+        {
+            if (comp(std::as_const(Hook::template from_node<T>(*second)),
+                     std::as_const(Hook::template from_node<T>(*first))))
+            {
+                last->next = second;
+                second = second->next;
+            }
+            else
+            {
+                last->next = first;
+                first = first->next;
+            }
+            last = last->next;
+        }
+        last->next = first ? first : second;
+
+        return dummy.next;
+    }
+
+    /// @brief Unlinks the nodes `[first, last]` from their list, and links them before `pos`.
+    static void relink_range(IntrusiveListNode* pos, IntrusiveListNode* first, IntrusiveListNode* last)
+    {
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+
+        first->prev = pos->prev;
+        last->next = pos;
+        pos->prev->next = first;
+        pos->prev = last;
+    }
+
+    void reset_links() noexcept
+    {
+        _size = 0;
+        _head.next = &_tail;
+        _tail.prev = &_head;
+    }
+
+    static void mark_unlinked(IntrusiveListNode& node) noexcept
+    {
+        node.prev = nullptr;
+        node.next = nullptr;
+    }
+
+    void add_size([[maybe_unused]] size_type count) noexcept
+    {
+        if constexpr (ConstantTimeSize)
+            _size += count;
+    }
+
+    void sub_size([[maybe_unused]] size_type count) noexcept
+    {
+        if constexpr (ConstantTimeSize)
+            _size -= count;
+    }
+
     auto link_new_node(const_iterator pos, IntrusiveListNode& new_node) -> iterator
     {
+        if constexpr (AUTO_UNLINK)
+            assert(!new_node.next && "Node is already linked");
+
         new_node.next = pos._node;
         new_node.prev = pos._node->prev;
         pos._node->prev->next = &new_node;
@@ -459,7 +1035,7 @@ private:
     }
 
 private:
-    size_type _size;
+    size_type _size; // not maintained if `ConstantTimeSize` is `false`
 
     IntrusiveListNode _head;
     IntrusiveListNode _tail;
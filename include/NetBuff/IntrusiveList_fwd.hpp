@@ -1,5 +1,6 @@
 #pragma once
 
+#include <concepts>
 #include <type_traits>
 
 namespace nb
@@ -8,8 +9,44 @@ namespace nb
 // Your custom type `A` should inherit this to store it inside `InstrusiveList<A>`
 struct IntrusiveListNode;
 
-template <typename T>
-    requires std::is_base_of_v<IntrusiveListNode, T>
+// Inherit `TaggedIntrusiveListNode<Tag>` for each list with a distinct `Tag`, to store `A` in several lists at once
+template <typename Tag>
+struct TaggedIntrusiveListNode;
+
+// Inherit `AutoUnlinkIntrusiveListNode<Tag>` to query `is_linked()`, and to have `A` unlink itself on destruction.
+// As it unlinks without the list knowing, it can only be linked to `IntrusiveList<A, false, ...>`.
+template <typename Tag = void>
+struct AutoUnlinkIntrusiveListNode;
+
+/// @brief Hook to link `T` via its base `IntrusiveListNode` (`Tag = void`) or `TaggedIntrusiveListNode<Tag>`.
+template <typename Tag = void>
+struct IntrusiveListBaseHook;
+
+/// @brief Hook to link `T` via its base `AutoUnlinkIntrusiveListNode<Tag>`.
+template <typename Tag = void>
+struct IntrusiveListAutoUnlinkHook;
+
+/// @brief Hook to link `T` via its member `IntrusiveListNode` or `AutoUnlinkIntrusiveListNode<Tag>`,
+/// like `IntrusiveListMemberHook<&T::node>`.
+///
+/// `T` must be a standard-layout class, as it's located from the node by the offset of the member.
+template <auto Member>
+struct IntrusiveListMemberHook;
+
+/// @brief `Hook` converts between `T` and the `IntrusiveListNode` linked to an `IntrusiveList`.
+template <typename Hook, typename T>
+concept IntrusiveListHookOf = requires(T& obj, const T& const_obj, IntrusiveListNode& node) {
+    { Hook::to_node(obj) } -> std::same_as<IntrusiveListNode&>;
+    { Hook::to_node(const_obj) } -> std::same_as<const IntrusiveListNode&>;
+    { Hook::template from_node<T>(node) } -> std::same_as<T&>;
+};
+
+/// @tparam ConstantTimeSize If this is `false`, the size is not maintained so that range splices are O(1),
+/// but `size()` becomes O(n).
+/// @tparam Hook Which `IntrusiveListNode` of `T` to link.
+/// An auto-unlink hook requires `ConstantTimeSize` to be `false`.
+template <typename T, bool ConstantTimeSize = true, typename Hook = IntrusiveListBaseHook<>>
+    requires IntrusiveListHookOf<Hook, T>
 class IntrusiveList;
 
 } // namespace nb
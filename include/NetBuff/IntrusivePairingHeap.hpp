@@ -0,0 +1,275 @@
+#pragma once
+
+#include "NetBuff/IntrusivePairingHeap_fwd.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+namespace nb
+{
+
+struct IntrusivePairingHeapNode
+{
+private:
+    template <typename T, typename Compare>
+        requires std::is_base_of_v<IntrusivePairingHeapNode, T>
+    friend class IntrusivePairingHeap;
+
+    IntrusivePairingHeapNode* child; // leftmost child
+    IntrusivePairingHeapNode* next;  // right sibling
+    IntrusivePairingHeapNode* prev;  // left sibling, or parent if it's the leftmost child
+};
+
+/// @brief Intrusive min-heap ordered by `Compare{}(const T&, const T&)`, with O(1) `push()` & `top()`,
+/// and amortized O(log n) `pop()`.
+///
+/// `top()` is the element that's not greater than any other, i.e. the opposite of `std::priority_queue`.
+/// Elements with equal keys pop in unspecified order, so add a sequence number to the key if you need FIFO.
+///
+/// The hook is 3 pointers and nothing is allocated, so you can schedule objects from an `ObjectPool`:
+/// ```
+/// struct Packet : nb::IntrusivePairingHeapNode { std::uint8_t priority; std::uint64_t deadline; ... };
+/// struct PacketOrder { bool operator()(const Packet& a, const Packet& b) const { return ...; } };
+///
+/// nb::IntrusivePairingHeap<Packet, PacketOrder> queue;
+/// queue.push(pool.construct(...));
+/// pool.destroy(queue.pop());
+/// ```
+template <typename T, typename Compare>
+    requires std::is_base_of_v<IntrusivePairingHeapNode, T>
+class IntrusivePairingHeap
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using value_compare = Compare;
+
+public:
+    IntrusivePairingHeap() noexcept : _root(nullptr), _size(0)
+    {
+    }
+
+    IntrusivePairingHeap(const IntrusivePairingHeap&) = delete;
+
+    IntrusivePairingHeap(IntrusivePairingHeap&& other) noexcept : IntrusivePairingHeap()
+    {
+        swap(other);
+    }
+
+    // Move and swap idiom
+    IntrusivePairingHeap& operator=(IntrusivePairingHeap other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+public: // Element access
+    auto top() -> reference
+    {
+        assert(!empty());
+        return static_cast<reference>(*_root);
+    }
+
+    auto top() const -> const_reference
+    {
+        assert(!empty());
+        return static_cast<const_reference>(*_root);
+    }
+
+public: // Capacity
+    bool empty() const noexcept
+    {
+        return _root == nullptr;
+    }
+
+    auto size() const noexcept -> size_type
+    {
+        return _size;
+    }
+
+public: // Modifiers
+    /// @brief Unlinks all elements in O(1), without touching them.
+    void clear() noexcept
+    {
+        _root = nullptr;
+        _size = 0;
+    }
+
+    /// @brief Inserts `value` in O(1).
+    void push(reference value)
+    {
+        IntrusivePairingHeapNode* node = &value;
+        node->child = nullptr;
+        node->next = nullptr;
+        node->prev = nullptr;
+
+        _root = _root ? link(_root, node) : node;
+        ++_size;
+    }
+
+    /// @brief Removes the top element in amortized O(log n), and returns it.
+    auto pop() -> reference
+    {
+        assert(!empty());
+
+        IntrusivePairingHeapNode* old_root = _root;
+        _root = merge_children(old_root);
+        --_size;
+
+        return static_cast<reference>(*old_root);
+    }
+
+    /// @brief Removes `value`, which should be in this heap, in amortized O(log n).
+    void erase(reference value)
+    {
+        IntrusivePairingHeapNode* node = &value;
+
+        if (node == _root)
+        {
+            pop();
+            return;
+        }
+
+        detach(node);
+        if (IntrusivePairingHeapNode* children = merge_children(node))
+            _root = link(_root, children);
+        --_size;
+    }
+
+    /// @brief Restores the order in O(1) after the key of `value` has decreased, i.e. it can only move up.
+    void decrease(reference value)
+    {
+        IntrusivePairingHeapNode* node = &value;
+
+        if (node == _root)
+            return;
+
+        detach(node);
+        _root = link(_root, node);
+    }
+
+    /// @brief Restores the order in amortized O(log n) after the key of `value` has changed in either direction.
+    void update(reference value)
+    {
+        erase(value);
+        push(value);
+    }
+
+    /// @brief Moves all elements of `other` to this heap in O(1).
+    void merge(IntrusivePairingHeap& other)
+    {
+        assert(&other != this);
+
+        if (other.empty())
+            return;
+
+        _root = _root ? link(_root, other._root) : other._root;
+        _size += other._size;
+        other.clear();
+    }
+
+    void merge(IntrusivePairingHeap&& other)
+    {
+        merge(other);
+    }
+
+    void swap(IntrusivePairingHeap& other) noexcept
+    {
+        using std::swap; // ADL
+
+        swap(_root, other._root);
+        swap(_size, other._size);
+    }
+
+private:
+    static bool less(const IntrusivePairingHeapNode* lhs, const IntrusivePairingHeapNode* rhs)
+    {
+        return Compare{}(static_cast<const_reference>(*lhs), static_cast<const_reference>(*rhs));
+    }
+
+    /// @brief Links two roots, making the greater one the leftmost child of the other, which is returned.
+    static auto link(IntrusivePairingHeapNode* first, IntrusivePairingHeapNode* second) -> IntrusivePairingHeapNode*
+    {
+        if (less(second, first))
+            std::swap(first, second);
+
+        second->prev = first;
+        second->next = first->child;
+        if (first->child)
+            first->child->prev = second;
+        first->child = second;
+
+        first->next = nullptr;
+        first->prev = nullptr;
+        return first;
+    }
+
+    /// @brief Cuts the subtree of the non-root `node` from its parent & siblings.
+    static void detach(IntrusivePairingHeapNode* node)
+    {
+        if (node->prev->child == node)
+            node->prev->child = node->next;
+        else
+            node->prev->next = node->next;
+
+        if (node->next)
+            node->next->prev = node->prev;
+
+        node->next = nullptr;
+        node->prev = nullptr;
+    }
+
+    /// @brief Merges the children of `node` into a single tree with the two-pass pairing, and returns its root.
+    static auto merge_children(IntrusivePairingHeapNode* node) -> IntrusivePairingHeapNode*
+    {
+        IntrusivePairingHeapNode* child = node->child;
+        node->child = nullptr;
+
+        // 1st pass: link the children in pairs from left to right, stacking the results with `next`
+        IntrusivePairingHeapNode* pairs = nullptr;
+        while (child)
+        {
+            IntrusivePairingHeapNode* first = child;
+            IntrusivePairingHeapNode* second = first->next;
+            if (!second)
+            {
+                first->next = pairs;
+                pairs = first;
+                break;
+            }
+            child = second->next;
+
+            IntrusivePairingHeapNode* pair = link(first, second);
+            pair->next = pairs;
+            pairs = pair;
+        }
+
+        // 2nd pass: link the pairs from right to left
+        IntrusivePairingHeapNode* result = pairs;
+        if (result)
+        {
+            pairs = pairs->next;
+            result->next = nullptr;
+            result->prev = nullptr;
+        }
+        while (pairs)
+        {
+            IntrusivePairingHeapNode* pair = pairs;
+            pairs = pairs->next;
+            result = link(result, pair);
+        }
+
+        return result;
+    }
+
+private:
+    IntrusivePairingHeapNode* _root;
+    size_type _size;
+};
+
+} // namespace nb
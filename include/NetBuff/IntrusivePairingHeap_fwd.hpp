@@ -0,0 +1,18 @@
+#pragma once
+
+#include <functional>
+#include <type_traits>
+
+namespace nb
+{
+
+// Your custom type `A` should inherit this to store it inside `IntrusivePairingHeap<A>`
+struct IntrusivePairingHeapNode;
+
+/// @brief Intrusive min-heap ordered by `Compare{}(const T&, const T&)`, with O(1) `push()` & `top()`,
+/// and amortized O(log n) `pop()`.
+template <typename T, typename Compare = std::less<T>>
+    requires std::is_base_of_v<IntrusivePairingHeapNode, T>
+class IntrusivePairingHeap;
+
+} // namespace nb
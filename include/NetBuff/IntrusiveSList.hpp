@@ -0,0 +1,346 @@
+#pragma once
+
+#include "NetBuff/IntrusiveSList_fwd.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace nb
+{
+
+template <typename T>
+    requires std::is_base_of_v<IntrusiveSListNode, T>
+class LockfreeIntrusiveStack;
+
+template <typename T>
+    requires std::is_base_of_v<IntrusiveSListNode, T>
+class MpscIntrusiveQueue;
+
+struct IntrusiveSListNode
+{
+private:
+    template <typename T>
+        requires std::is_base_of_v<IntrusiveSListNode, T>
+    friend class IntrusiveSList;
+
+    template <typename T>
+        requires std::is_base_of_v<IntrusiveSListNode, T>
+    friend class LockfreeIntrusiveStack;
+
+    template <typename T>
+        requires std::is_base_of_v<IntrusiveSListNode, T>
+    friend class MpscIntrusiveQueue;
+
+    /// @brief Store the link atomically, as a node just popped from `LockfreeIntrusiveStack` might be still read
+    /// by another thread, while being relinked.
+    ///
+    /// Relaxed atomic store compiles to a plain store on major architectures.
+    void store_next(IntrusiveSListNode* node) noexcept
+    {
+        std::atomic_ref<IntrusiveSListNode*>(next).store(node, std::memory_order_relaxed);
+    }
+
+    IntrusiveSListNode* next;
+};
+
+/// @brief Singly linked intrusive list, with O(1) `push_front()`, `push_back()`, `pop_front()` & `splice_back()`.
+///
+/// Unlike `IntrusiveList`, the hook is a single pointer and there's no sentinel node,
+/// which suits free lists and work queues that only push & pop.
+template <typename T>
+    requires std::is_base_of_v<IntrusiveSListNode, T>
+class IntrusiveSList
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+private:
+    template <bool IsConst>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = IntrusiveSList::value_type;
+        using difference_type = IntrusiveSList::difference_type;
+        using reference = std::conditional_t<IsConst, IntrusiveSList::const_reference, IntrusiveSList::reference>;
+        using pointer = std::conditional_t<IsConst, IntrusiveSList::const_pointer, IntrusiveSList::pointer>;
+
+    private:
+        friend class IntrusiveSList;
+        friend class Iterator<!IsConst>;
+
+        IntrusiveSListNode* _node;
+
+    public:
+        // To satisfy requirements of `std::forward_iterator` concept, public default-initialization is required
+        explicit Iterator(const IntrusiveSListNode* node = nullptr) : _node(const_cast<IntrusiveSListNode*>(node))
+        {
+        }
+
+        // Conversion from `iterator` to `const_iterator`
+        template <bool OtherIsConst>
+            requires(IsConst && !OtherIsConst)
+        Iterator(const Iterator<OtherIsConst>& other) : _node(other._node)
+        {
+        }
+
+    public:
+        auto operator*() const -> reference
+        {
+            return static_cast<reference>(*_node);
+        }
+
+        auto operator->() const -> pointer
+        {
+            return static_cast<pointer>(_node);
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return _node == other._node;
+        }
+
+        auto operator++() -> Iterator&
+        {
+            _node = _node->next;
+            return *this;
+        }
+
+        auto operator++(int) -> Iterator
+        {
+            auto it = *this;
+            operator++();
+            return it;
+        }
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    static_assert(std::forward_iterator<iterator>);
+    static_assert(std::forward_iterator<const_iterator>);
+
+public:
+    IntrusiveSList() noexcept : _head(nullptr), _tail(nullptr), _size(0)
+    {
+    }
+
+    IntrusiveSList(const IntrusiveSList&) = delete;
+
+    IntrusiveSList(IntrusiveSList&& other) noexcept : IntrusiveSList()
+    {
+        swap(other);
+    }
+
+    // Move and swap idiom
+    IntrusiveSList& operator=(IntrusiveSList other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+public: // Element access
+    auto front() -> reference
+    {
+        return static_cast<reference>(*_head);
+    }
+
+    auto front() const -> const_reference
+    {
+        return static_cast<const_reference>(*_head);
+    }
+
+    auto back() -> reference
+    {
+        return static_cast<reference>(*_tail);
+    }
+
+    auto back() const -> const_reference
+    {
+        return static_cast<const_reference>(*_tail);
+    }
+
+public: // Iterators
+    auto begin() noexcept -> iterator
+    {
+        return iterator(_head);
+    }
+
+    auto begin() const noexcept -> const_iterator
+    {
+        return const_iterator(_head);
+    }
+
+    auto cbegin() const noexcept -> const_iterator
+    {
+        return const_iterator(_head);
+    }
+
+    auto end() noexcept -> iterator
+    {
+        return iterator(nullptr);
+    }
+
+    auto end() const noexcept -> const_iterator
+    {
+        return const_iterator(nullptr);
+    }
+
+    auto cend() const noexcept -> const_iterator
+    {
+        return const_iterator(nullptr);
+    }
+
+public: // Capacity
+    bool empty() const noexcept
+    {
+        return _head == nullptr;
+    }
+
+    auto size() const noexcept -> size_type
+    {
+        return _size;
+    }
+
+public: // Modifiers
+    void clear() noexcept
+    {
+        _head = nullptr;
+        _tail = nullptr;
+        _size = 0;
+    }
+
+    void push_front(reference value) noexcept
+    {
+        IntrusiveSListNode& node = value;
+        node.store_next(_head);
+        _head = &node;
+        if (!_tail)
+            _tail = &node;
+
+        ++_size;
+    }
+
+    void push_back(reference value) noexcept
+    {
+        IntrusiveSListNode& node = value;
+        node.store_next(nullptr);
+        if (_tail)
+            _tail->store_next(&node);
+        else
+            _head = &node;
+        _tail = &node;
+
+        ++_size;
+    }
+
+    void pop_front() noexcept
+    {
+        assert(!empty());
+
+        _head = _head->next;
+        if (!_head)
+            _tail = nullptr;
+
+        --_size;
+    }
+
+    /// @brief Inserts `value` after `pos`, which should be dereferenceable.
+    auto insert_after(const_iterator pos, reference value) noexcept -> iterator
+    {
+        IntrusiveSListNode& node = value;
+        node.store_next(pos._node->next);
+        pos._node->store_next(&node);
+        if (_tail == pos._node)
+            _tail = &node;
+
+        ++_size;
+        return iterator(&node);
+    }
+
+    auto insert_after(const_reference pos, reference value) noexcept -> iterator
+    {
+        return insert_after(const_iterator(&pos), value);
+    }
+
+    /// @brief Erases the element after `pos`, which should exist.
+    ///
+    /// @return Iterator to the element after the erased one
+    auto erase_after(const_iterator pos) noexcept -> iterator
+    {
+        IntrusiveSListNode* del_node = pos._node->next;
+        assert(del_node);
+
+        pos._node->store_next(del_node->next);
+        if (_tail == del_node)
+            _tail = pos._node;
+
+        --_size;
+        return iterator(pos._node->next);
+    }
+
+    auto erase_after(const_reference pos) noexcept -> iterator
+    {
+        return erase_after(const_iterator(&pos));
+    }
+
+    /// @brief Moves all elements of `other` to the back in O(1).
+    void splice_back(IntrusiveSList& other) noexcept
+    {
+        assert(&other != this);
+
+        if (other.empty())
+            return;
+
+        if (_tail)
+            _tail->store_next(other._head);
+        else
+            _head = other._head;
+        _tail = other._tail;
+        _size += other._size;
+
+        other.clear();
+    }
+
+    void splice_back(IntrusiveSList&& other) noexcept
+    {
+        splice_back(other);
+    }
+
+    void swap(IntrusiveSList& other) noexcept
+    {
+        using std::swap; // ADL
+
+        swap(_head, other._head);
+        swap(_tail, other._tail);
+        swap(_size, other._size);
+    }
+
+private:
+    friend class LockfreeIntrusiveStack<T>;
+
+    /// @brief Adopts the `size` nodes chained from `head` to `tail`.
+    void assign_chain(IntrusiveSListNode* head, IntrusiveSListNode* tail, size_type size) noexcept
+    {
+        _head = head;
+        _tail = tail;
+        _size = size;
+    }
+
+private:
+    IntrusiveSListNode* _head;
+    IntrusiveSListNode* _tail;
+    size_type _size;
+};
+
+} // namespace nb
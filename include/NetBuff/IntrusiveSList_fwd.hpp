@@ -0,0 +1,17 @@
+#pragma once
+
+#include <type_traits>
+
+namespace nb
+{
+
+// Your custom type `A` should inherit this to store it inside `IntrusiveSList<A>`,
+// `LockfreeIntrusiveStack<A>` or `MpscIntrusiveQueue<A>`
+struct IntrusiveSListNode;
+
+/// @brief Singly linked intrusive list, with O(1) `push_front()`, `push_back()`, `pop_front()` & `splice_back()`.
+template <typename T>
+    requires std::is_base_of_v<IntrusiveSListNode, T>
+class IntrusiveSList;
+
+} // namespace nb
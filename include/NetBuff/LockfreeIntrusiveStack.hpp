@@ -0,0 +1,137 @@
+#pragma once
+
+#include "NetBuff/LockfreeIntrusiveStack_fwd.hpp"
+
+#include "NetBuff/IntrusiveSList.hpp"
+#include "NetBuff/TaggedPtr.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+namespace nb
+{
+
+/// @brief Lock-free intrusive stack (Treiber stack) of `T`s inheriting `IntrusiveSListNode`.
+///
+/// Any thread can push & pop, without allocating at all, which suits handing off pooled objects across threads.
+/// The tag of the head pointer is increased on every pop, to prevent the ABA problem.
+///
+/// As a popping thread might read the link of a node which is just popped by another thread,
+/// the memory of nodes should stay valid while the stack is in use. (e.g. objects of an object pool)
+template <typename T>
+    requires std::is_base_of_v<IntrusiveSListNode, T>
+class LockfreeIntrusiveStack
+{
+public:
+    using value_type = T;
+    using reference = T&;
+    using pointer = T*;
+
+public:
+    LockfreeIntrusiveStack() : _head(TaggedPtr<IntrusiveSListNode>())
+    {
+    }
+
+    LockfreeIntrusiveStack(const LockfreeIntrusiveStack&) = delete;
+    LockfreeIntrusiveStack& operator=(const LockfreeIntrusiveStack&) = delete;
+
+public:
+    void push(reference value)
+    {
+        IntrusiveSListNode& node = value;
+        push_chain(&node, &node);
+    }
+
+    /// @brief Pushes all elements of `list` at once, so that `list.front()` is popped first.
+    void push(IntrusiveSList<T>& list)
+    {
+        if (list.empty())
+            return;
+
+        push_chain(list._head, list._tail);
+        list.clear();
+    }
+
+    void push(IntrusiveSList<T>&& list)
+    {
+        push(list);
+    }
+
+    /// @return `nullptr` if empty
+    [[nodiscard]] auto try_pop() -> pointer
+    {
+        TaggedPtr<IntrusiveSListNode> cur = _head.load(std::memory_order_acquire);
+        for (;;)
+        {
+            if (!cur)
+                return nullptr;
+
+            // `cur` might be popped & pushed again by another thread meanwhile, but the tag makes CAS fail then
+            TaggedPtr<IntrusiveSListNode> next(load_next(*cur), cur.get_tag() + 1);
+
+            if (_head.compare_exchange_weak(cur, next, std::memory_order_acquire, std::memory_order_acquire))
+                return static_cast<pointer>(cur.get_ptr());
+        }
+    }
+
+    /// @brief Pops all elements at once, in LIFO order.
+    [[nodiscard]] auto pop_all() -> IntrusiveSList<T>
+    {
+        TaggedPtr<IntrusiveSListNode> cur = _head.load(std::memory_order_relaxed);
+        TaggedPtr<IntrusiveSListNode> empty;
+        do
+        {
+            empty.set_tag(cur.get_tag() + 1);
+        } while (!_head.compare_exchange_weak(cur, empty, std::memory_order_acquire, std::memory_order_relaxed));
+
+        // the chain is owned by this thread now
+        IntrusiveSList<T> list;
+        if (cur)
+        {
+            IntrusiveSListNode* tail = cur.get_ptr();
+            std::size_t size = 1;
+            for (; tail->next; tail = tail->next)
+                ++size;
+
+            list.assign_chain(cur.get_ptr(), tail, size);
+        }
+
+        return list;
+    }
+
+    /// @brief Checks if it's empty, which might be changed right after by other threads.
+    bool empty() const
+    {
+        return !_head.load(std::memory_order_relaxed);
+    }
+
+private:
+    void push_chain(IntrusiveSListNode* first, IntrusiveSListNode* last)
+    {
+        TaggedPtr<IntrusiveSListNode> old_head = _head.load(std::memory_order_relaxed);
+        TaggedPtr<IntrusiveSListNode> new_head(first);
+        for (;;)
+        {
+            // prepare `new_head`
+            last->store_next(old_head.get_ptr());
+            new_head.set_tag(old_head.get_tag());
+
+            // try exchanging `_head` to `new_head`, and break if succeeds
+            if (_head.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_relaxed))
+                break;
+        }
+    }
+
+    // the link is read atomically, as it can be relinked by another thread which popped `node` meanwhile
+    static auto load_next(IntrusiveSListNode& node) -> IntrusiveSListNode*
+    {
+        return std::atomic_ref<IntrusiveSListNode*>(node.next).load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<TaggedPtr<IntrusiveSListNode>> _head;
+
+    static_assert(std::atomic<TaggedPtr<IntrusiveSListNode>>::is_always_lock_free);
+};
+
+} // namespace nb
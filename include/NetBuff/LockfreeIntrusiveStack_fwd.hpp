@@ -0,0 +1,15 @@
+#pragma once
+
+#include <type_traits>
+
+namespace nb
+{
+
+struct IntrusiveSListNode;
+
+/// @brief Lock-free intrusive stack (Treiber stack) of `T`s inheriting `IntrusiveSListNode`.
+template <typename T>
+    requires std::is_base_of_v<IntrusiveSListNode, T>
+class LockfreeIntrusiveStack;
+
+} // namespace nb
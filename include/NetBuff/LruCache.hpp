@@ -0,0 +1,358 @@
+#pragma once
+
+#include "NetBuff/LruCache_fwd.hpp"
+
+#include "NetBuff/IntrusiveList.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace nb
+{
+
+struct LruCacheNode : public TaggedIntrusiveListNode<LruCacheNode>
+{
+private:
+    template <typename Key, typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+        requires std::is_base_of_v<LruCacheNode, T>
+    friend class LruCache;
+
+    std::uint64_t _lru_hash; // mixed hash of the key, cached to skip key comparisons & re-hashing
+};
+
+/// @brief Intrusive LRU cache, which indexes `T`s by `KeyOf{}(const T&)` without allocating per entry.
+///
+/// Objects are linked to a recency list (`IntrusiveList`), and indexed by an open-addressing hash table of pointers,
+/// which is allocated once on construction. So lookups, insertions & evictions don't allocate at all.
+///
+/// The cache doesn't own objects: `insert()` returns the evicted object, which you can return to your `ObjectPool`.
+/// ```
+/// T* obj = cache.find(key);
+/// if (!obj)
+/// {
+///     obj = &pool.construct(key);
+///     if (T* evicted = cache.insert(*obj))
+///         pool.destroy(*evicted);
+/// }
+/// ```
+template <typename Key, typename T, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+    requires std::is_base_of_v<LruCacheNode, T>
+class LruCache : private std::allocator_traits<Allocator>::template rebind_alloc<T*>
+{
+public:
+    using PointerAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T*>;
+
+    using key_type = Key;
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+private:
+    // tagged, so that cached objects can be in other `IntrusiveList`s too
+    using List = IntrusiveList<T, true, IntrusiveListBaseHook<LruCacheNode>>;
+
+public:
+    // Most recently used first
+    using iterator = typename List::iterator;
+    using const_iterator = typename List::const_iterator;
+
+private:
+    static constexpr size_type NPOS = static_cast<size_type>(-1);
+
+public:
+    LruCache() : LruCache(0)
+    {
+    }
+
+    /// @param capacity Max number of objects, the index table is sized to keep the load factor at most 0.5
+    explicit LruCache(size_type capacity) : _table(nullptr), _table_bits(0), _capacity(capacity)
+    {
+        if (_capacity != 0)
+        {
+            const size_type table_size = std::bit_ceil(std::max<size_type>(_capacity * 2, 2));
+            _table_bits = static_cast<unsigned>(std::countr_zero(table_size));
+
+            _table = std::allocator_traits<PointerAllocator>::allocate(*this, table_size);
+            std::fill_n(_table, table_size, nullptr);
+        }
+    }
+
+    LruCache(const LruCache&) = delete;
+
+    LruCache(LruCache&& other) noexcept : LruCache(0)
+    {
+        swap(other);
+    }
+
+    // Move and swap idiom
+    LruCache& operator=(LruCache other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~LruCache()
+    {
+        if (_table)
+            std::allocator_traits<PointerAllocator>::deallocate(*this, _table, table_size());
+    }
+
+public:
+    /// @brief Find the object of `key`, and mark it as the most recently used.
+    ///
+    /// @return `nullptr` if not found
+    auto find(const Key& key) -> pointer
+    {
+        const size_type idx = find_index(key);
+        if (idx == NPOS)
+            return nullptr;
+
+        touch(*_table[idx]);
+        return _table[idx];
+    }
+
+    /// @brief Find the object of `key`, without changing the recency.
+    ///
+    /// @return `nullptr` if not found
+    auto peek(const Key& key) const -> const_pointer
+    {
+        const size_type idx = find_index(key);
+        return (idx == NPOS) ? nullptr : _table[idx];
+    }
+
+    bool contains(const Key& key) const
+    {
+        return find_index(key) != NPOS;
+    }
+
+    /// @brief Mark `obj` in the cache as the most recently used, in O(1).
+    void touch(reference obj)
+    {
+        _list.erase(obj);
+        _list.push_front(obj);
+    }
+
+    /// @brief Insert `obj` as the most recently used, which key should not be in the cache.
+    ///
+    /// @return The least recently used object evicted to make room for `obj`, or `nullptr` if not full
+    auto insert(reference obj) -> pointer
+    {
+        assert(_capacity != 0);
+        assert(!contains(KeyOf{}(obj)));
+
+        pointer evicted = nullptr;
+        if (full())
+        {
+            evicted = &pop_lru();
+        }
+
+        obj._lru_hash = mix_hash(Hash{}(KeyOf{}(obj)));
+
+        size_type idx = home_index(obj._lru_hash);
+        while (_table[idx])
+            idx = next_index(idx);
+        _table[idx] = &obj;
+
+        _list.push_front(obj);
+
+        return evicted;
+    }
+
+    /// @brief Remove `obj` in the cache, in O(1) on average.
+    void erase(reference obj)
+    {
+        size_type idx = home_index(obj._lru_hash);
+        while (_table[idx] != &obj)
+        {
+            assert(_table[idx]);
+            idx = next_index(idx);
+        }
+
+        erase_index(idx);
+        _list.erase(obj);
+    }
+
+    /// @brief Remove the object of `key`.
+    ///
+    /// @return The removed object, or `nullptr` if not found
+    auto erase(const Key& key) -> pointer
+    {
+        const size_type idx = find_index(key);
+        if (idx == NPOS)
+            return nullptr;
+
+        pointer obj = _table[idx];
+        erase_index(idx);
+        _list.erase(*obj);
+
+        return obj;
+    }
+
+    /// @brief Remove the least recently used object, which should exist.
+    auto pop_lru() -> reference
+    {
+        assert(!empty());
+
+        reference obj = _list.back();
+        erase(obj);
+        return obj;
+    }
+
+    /// @brief Remove all objects, without touching them.
+    void clear() noexcept
+    {
+        _list.clear();
+        if (_table)
+            std::fill_n(_table, table_size(), nullptr);
+    }
+
+    void swap(LruCache& other) noexcept
+    {
+        using std::swap; // ADL
+
+        _list.swap(other._list);
+        swap(_table, other._table);
+        swap(_table_bits, other._table_bits);
+        swap(_capacity, other._capacity);
+    }
+
+public:
+    auto lru() -> reference
+    {
+        return _list.back();
+    }
+
+    auto lru() const -> const_reference
+    {
+        return _list.back();
+    }
+
+    auto mru() -> reference
+    {
+        return _list.front();
+    }
+
+    auto mru() const -> const_reference
+    {
+        return _list.front();
+    }
+
+    auto begin() noexcept -> iterator
+    {
+        return _list.begin();
+    }
+
+    auto begin() const noexcept -> const_iterator
+    {
+        return _list.begin();
+    }
+
+    auto end() noexcept -> iterator
+    {
+        return _list.end();
+    }
+
+    auto end() const noexcept -> const_iterator
+    {
+        return _list.end();
+    }
+
+public:
+    bool empty() const noexcept
+    {
+        return _list.empty();
+    }
+
+    bool full() const noexcept
+    {
+        return _list.size() >= _capacity;
+    }
+
+    auto size() const noexcept -> size_type
+    {
+        return _list.size();
+    }
+
+    auto capacity() const noexcept -> size_type
+    {
+        return _capacity;
+    }
+
+private:
+    /// @brief Spread `hash` over the upper bits, as `std::hash` of integers might be an identity function.
+    static auto mix_hash(std::size_t hash) noexcept -> std::uint64_t
+    {
+        return static_cast<std::uint64_t>(hash) * 0x9E37'79B9'7F4A'7C15; // Fibonacci hashing
+    }
+
+    auto home_index(std::uint64_t mixed_hash) const noexcept -> size_type
+    {
+        return static_cast<size_type>(mixed_hash >> (64 - _table_bits));
+    }
+
+    auto next_index(size_type idx) const noexcept -> size_type
+    {
+        return (idx + 1) & (table_size() - 1);
+    }
+
+    auto table_size() const noexcept -> size_type
+    {
+        return size_type(1) << _table_bits;
+    }
+
+    auto find_index(const Key& key) const -> size_type
+    {
+        if (empty())
+            return NPOS;
+
+        const std::uint64_t mixed_hash = mix_hash(Hash{}(key));
+
+        for (size_type idx = home_index(mixed_hash); _table[idx]; idx = next_index(idx))
+        {
+            if (_table[idx]->_lru_hash == mixed_hash && KeyEqual{}(KeyOf{}(*_table[idx]), key))
+                return idx;
+        }
+
+        return NPOS;
+    }
+
+    /// @brief Empty the slot `idx`, and shift back the following entries to keep the probe sequences intact.
+    void erase_index(size_type idx)
+    {
+        for (size_type next = next_index(idx);; next = next_index(next))
+        {
+            _table[idx] = nullptr;
+
+            // shift back entries until an empty slot, unless its home is cyclically in `(idx, next]`
+            for (;; next = next_index(next))
+            {
+                if (!_table[next])
+                    return;
+
+                const size_type home = home_index(_table[next]->_lru_hash);
+                const bool stays = (idx <= next) ? (idx < home && home <= next) : (idx < home || home <= next);
+                if (!stays)
+                    break;
+            }
+
+            _table[idx] = _table[next];
+            idx = next;
+        }
+    }
+
+private:
+    List _list;
+
+    pointer* _table;
+    unsigned _table_bits;
+    size_type _capacity;
+};
+
+} // namespace nb
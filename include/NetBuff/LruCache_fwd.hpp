@@ -0,0 +1,19 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace nb
+{
+
+// Your custom type `T` should inherit this to store it inside `LruCache<Key, T, KeyOf>`
+struct LruCacheNode;
+
+/// @brief Intrusive LRU cache, which indexes `T`s by `KeyOf{}(const T&)` without allocating per entry.
+template <typename Key, typename T, typename KeyOf, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>, typename Allocator = std::allocator<T*>>
+    requires std::is_base_of_v<LruCacheNode, T>
+class LruCache;
+
+} // namespace nb
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "NetBuff/MpscIntrusiveQueue_fwd.hpp"
+
+#include "NetBuff/IntrusiveSList.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace nb
+{
+
+/// @brief Lock-free intrusive multi-producer single-consumer FIFO queue of `T`s inheriting `IntrusiveSListNode`.
+///
+/// Based on Dmitry Vyukov's intrusive MPSC queue:
+/// a producer exchanges the tail and then links the previous tail to its node, which is wait-free.
+/// As producers never read other nodes, ABA problem can't happen, and nodes can be destroyed right after being popped.
+///
+/// `try_pop()` might return `nullptr` if a producer is between those 2 steps, even if other nodes are pushed after.
+template <typename T>
+    requires std::is_base_of_v<IntrusiveSListNode, T>
+class MpscIntrusiveQueue
+{
+public:
+    using value_type = T;
+    using reference = T&;
+    using pointer = T*;
+
+public:
+    MpscIntrusiveQueue() : _tail(&_stub), _head(&_stub)
+    {
+        _stub.next = nullptr;
+    }
+
+    MpscIntrusiveQueue(const MpscIntrusiveQueue&) = delete;
+    MpscIntrusiveQueue& operator=(const MpscIntrusiveQueue&) = delete;
+
+public:
+    /// @brief Pushes `value`, which can be called by any thread.
+    void push(reference value)
+    {
+        IntrusiveSListNode& node = value;
+        push_node(node);
+    }
+
+    /// @brief Pops the oldest element, which should be called only by the consumer thread.
+    ///
+    /// @return `nullptr` if empty, or the next element is not linked yet
+    [[nodiscard]] auto try_pop() -> pointer
+    {
+        IntrusiveSListNode* head = _head;
+        IntrusiveSListNode* next = load_next(*head);
+
+        // skip the stub
+        if (head == &_stub)
+        {
+            if (!next)
+                return nullptr;
+
+            _head = next;
+            head = next;
+            next = load_next(*head);
+        }
+
+        if (next)
+        {
+            _head = next;
+            return static_cast<pointer>(head);
+        }
+
+        // `head` is the last one linked: a producer is linking the next one, or `head` is the tail
+        if (head != _tail.load(std::memory_order_acquire))
+            return nullptr;
+
+        // push the stub after `head`, so that `head` can be popped
+        push_node(_stub);
+
+        next = load_next(*head);
+        if (next)
+        {
+            _head = next;
+            return static_cast<pointer>(head);
+        }
+
+        return nullptr;
+    }
+
+    /// @brief Checks if it's empty, which should be called only by the consumer thread.
+    bool empty() const
+    {
+        return _head == &_stub && !load_next(_stub);
+    }
+
+private:
+    void push_node(IntrusiveSListNode& node)
+    {
+        node.store_next(nullptr);
+
+        IntrusiveSListNode* prev = _tail.exchange(&node, std::memory_order_acq_rel);
+        std::atomic_ref<IntrusiveSListNode*>(prev->next).store(&node, std::memory_order_release);
+    }
+
+    static auto load_next(const IntrusiveSListNode& node) -> IntrusiveSListNode*
+    {
+        return std::atomic_ref<IntrusiveSListNode*>(const_cast<IntrusiveSListNode&>(node).next)
+            .load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr std::size_t CACHE_LINE_SIZE = std::hardware_destructive_interference_size;
+
+    // written by producers
+    alignas(CACHE_LINE_SIZE) std::atomic<IntrusiveSListNode*> _tail;
+
+    // only accessed by the consumer
+    alignas(CACHE_LINE_SIZE) IntrusiveSListNode* _head;
+    IntrusiveSListNode _stub;
+
+    static_assert(std::atomic<IntrusiveSListNode*>::is_always_lock_free);
+};
+
+} // namespace nb
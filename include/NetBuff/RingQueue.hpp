@@ -2,9 +2,13 @@
 
 #include "NetBuff/RingQueue_fwd.hpp"
 
+#include <bit>
 #include <cassert>
+#include <compare>
 #include <cstddef>
+#include <iterator>
 #include <list>
+#include <type_traits>
 #include <utility>
 
 namespace nb
@@ -14,27 +18,177 @@ namespace nb
 ///
 /// If the reserved buffer is full, it DOESN'T increase its size automatically;
 /// You need to reserve it manually via `try_resize_buffer()`.
+///
+/// It stores exactly `capacity()` elements, with read & write indices running over `[0, 2 * capacity())`
+/// so that a full queue can be told apart from an empty one without a spare slot.
+/// If `capacity()` is a power of two, index wrapping is done with a bit mask instead of a comparison.
 template <typename T, typename Allocator>
 class RingQueue : private std::allocator_traits<Allocator>::template rebind_alloc<std::byte>
 {
 public:
     using ByteAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::byte>;
 
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+private:
+    /// @brief Random access iterator over the live elements, from `front()` to `back()`.
+    ///
+    /// It stores the offset from `front()`, so any `pop()` or resize invalidates all iterators,
+    /// not just the ones pointing to the popped element.
+    template <bool IsConst>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = RingQueue::value_type;
+        using difference_type = RingQueue::difference_type;
+        using reference = std::conditional_t<IsConst, RingQueue::const_reference, RingQueue::reference>;
+        using pointer = std::conditional_t<IsConst, RingQueue::const_pointer, RingQueue::pointer>;
+
+    private:
+        friend class RingQueue;
+        friend class Iterator<!IsConst>;
+
+        using Queue = std::conditional_t<IsConst, const RingQueue, RingQueue>;
+
+        Queue* _queue;
+        difference_type _offset; // logical offset from `front()`
+
+    public:
+        // To satisfy requirements of `std::random_access_iterator` concept, public default-initialization is required
+        Iterator() : _queue(nullptr), _offset(0)
+        {
+        }
+
+        // Conversion from `iterator` to `const_iterator`
+        template <bool OtherIsConst>
+            requires(IsConst && !OtherIsConst)
+        Iterator(const Iterator<OtherIsConst>& other) : _queue(other._queue), _offset(other._offset)
+        {
+        }
+
+    private:
+        Iterator(Queue* queue, difference_type offset) : _queue(queue), _offset(offset)
+        {
+        }
+
+    public:
+        auto operator*() const -> reference
+        {
+            return (*_queue)[_offset];
+        }
+
+        auto operator->() const -> pointer
+        {
+            return &(*_queue)[_offset];
+        }
+
+        auto operator[](difference_type diff) const -> reference
+        {
+            return (*_queue)[_offset + diff];
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return _offset == other._offset;
+        }
+
+        auto operator<=>(const Iterator& other) const -> std::strong_ordering
+        {
+            return _offset <=> other._offset;
+        }
+
+        auto operator++() -> Iterator&
+        {
+            ++_offset;
+            return *this;
+        }
+
+        auto operator++(int) -> Iterator
+        {
+            auto it = *this;
+            operator++();
+            return it;
+        }
+
+        auto operator--() -> Iterator&
+        {
+            --_offset;
+            return *this;
+        }
+
+        auto operator--(int) -> Iterator
+        {
+            auto it = *this;
+            operator--();
+            return it;
+        }
+
+        auto operator+=(difference_type diff) -> Iterator&
+        {
+            _offset += diff;
+            return *this;
+        }
+
+        auto operator-=(difference_type diff) -> Iterator&
+        {
+            _offset -= diff;
+            return *this;
+        }
+
+        auto operator+(difference_type diff) const -> Iterator
+        {
+            return Iterator(_queue, _offset + diff);
+        }
+
+        friend auto operator+(difference_type diff, const Iterator& it) -> Iterator
+        {
+            return it + diff;
+        }
+
+        auto operator-(difference_type diff) const -> Iterator
+        {
+            return Iterator(_queue, _offset - diff);
+        }
+
+        auto operator-(const Iterator& other) const -> difference_type
+        {
+            return _offset - other._offset;
+        }
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    static_assert(std::random_access_iterator<iterator>);
+    static_assert(std::random_access_iterator<const_iterator>);
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
 public:
     RingQueue() : RingQueue(0)
     {
     }
 
-    RingQueue(std::size_t capacity) : _capacity_plus_one(capacity + 1), _read_idx(0), _write_idx(0)
+    RingQueue(std::size_t capacity)
+        : _capacity(capacity), _idx_mask(calc_idx_mask(capacity)), _read_idx(0), _write_idx(0)
     {
         if (capacity)
         {
-            _alloc_size = (capacity + 1) * sizeof(T) + (alignof(T) - 1);
+            _alloc_size = capacity * sizeof(T) + (alignof(T) - 1);
             _alloc_addr = this->allocate(_alloc_size);
             _elements = reinterpret_cast<T*>(_alloc_addr);
             std::size_t space = _alloc_size;
             _elements = reinterpret_cast<T*>(
-                std::align(alignof(T), sizeof(T) * _capacity_plus_one, reinterpret_cast<void*&>(_elements), space));
+                std::align(alignof(T), sizeof(T) * _capacity, reinterpret_cast<void*&>(_elements), space));
             assert(_elements);
         }
         else
@@ -99,28 +253,103 @@ public:
 public: // Element access
     auto front() -> T&
     {
-        return _elements[_read_idx];
+        return _elements[slot_idx(_read_idx)];
     }
 
     auto front() const -> const T&
     {
-        return _elements[_read_idx];
+        return _elements[slot_idx(_read_idx)];
     }
 
     auto back() -> T&
     {
-        return _elements[move_idx(_write_idx, -1)];
+        return _elements[slot_idx(move_idx(_write_idx, -1))];
     }
 
     auto back() const -> const T&
     {
-        return _elements[move_idx(_write_idx, -1)];
+        return _elements[slot_idx(move_idx(_write_idx, -1))];
+    }
+
+    /// @brief Access the `pos`-th element from `front()`. (No bounds check)
+    auto operator[](size_type pos) -> T&
+    {
+        assert(pos < size());
+        return _elements[slot_idx(wrap_idx(_read_idx + pos))];
+    }
+
+    /// @brief Access the `pos`-th element from `front()`. (No bounds check)
+    auto operator[](size_type pos) const -> const T&
+    {
+        assert(pos < size());
+        return _elements[slot_idx(wrap_idx(_read_idx + pos))];
+    }
+
+public: // Iterators
+    auto begin() noexcept -> iterator
+    {
+        return iterator(this, 0);
+    }
+
+    auto begin() const noexcept -> const_iterator
+    {
+        return const_iterator(this, 0);
+    }
+
+    auto cbegin() const noexcept -> const_iterator
+    {
+        return const_iterator(this, 0);
+    }
+
+    auto end() noexcept -> iterator
+    {
+        return iterator(this, static_cast<difference_type>(size()));
+    }
+
+    auto end() const noexcept -> const_iterator
+    {
+        return const_iterator(this, static_cast<difference_type>(size()));
+    }
+
+    auto cend() const noexcept -> const_iterator
+    {
+        return const_iterator(this, static_cast<difference_type>(size()));
+    }
+
+    auto rbegin() noexcept -> reverse_iterator
+    {
+        return reverse_iterator(end());
+    }
+
+    auto rbegin() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator(end());
+    }
+
+    auto crbegin() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    auto rend() noexcept -> reverse_iterator
+    {
+        return reverse_iterator(begin());
+    }
+
+    auto rend() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    auto crend() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator(cbegin());
     }
 
 public: // Capacity
     auto capacity() const -> std::size_t
     {
-        return _capacity_plus_one - 1;
+        return _capacity;
     }
 
     bool empty() const
@@ -130,12 +359,12 @@ public: // Capacity
 
     bool full() const
     {
-        return move_idx(_write_idx, +1) == _read_idx;
+        return size() == _capacity;
     }
 
     auto size() const -> std::size_t
     {
-        return (_write_idx - _read_idx + _capacity_plus_one) % _capacity_plus_one;
+        return wrap_idx(_write_idx + 2 * _capacity - _read_idx);
     }
 
 public: // Modifiers
@@ -144,7 +373,7 @@ public: // Modifiers
         if (full())
             return false;
 
-        ::new (static_cast<void*>(_elements + _write_idx)) T(value);
+        ::new (static_cast<void*>(_elements + slot_idx(_write_idx))) T(value);
         _write_idx = move_idx(_write_idx, +1);
 
         return true;
@@ -155,7 +384,7 @@ public: // Modifiers
         if (full())
             return false;
 
-        ::new (static_cast<void*>(_elements + _write_idx)) T(std::move(value));
+        ::new (static_cast<void*>(_elements + slot_idx(_write_idx))) T(std::move(value));
         _write_idx = move_idx(_write_idx, +1);
 
         return true;
@@ -167,7 +396,7 @@ public: // Modifiers
         if (full())
             return false;
 
-        ::new (static_cast<void*>(_elements + _write_idx)) T(std::forward<Args>(args)...);
+        ::new (static_cast<void*>(_elements + slot_idx(_write_idx))) T(std::forward<Args>(args)...);
         _write_idx = move_idx(_write_idx, +1);
 
         return true;
@@ -187,7 +416,8 @@ public: // Modifiers
             swap<ByteAllocator>(*this, other);
 
         swap(_elements, other._elements);
-        swap(_capacity_plus_one, other._capacity_plus_one);
+        swap(_capacity, other._capacity);
+        swap(_idx_mask, other._idx_mask);
         swap(_read_idx, other._read_idx);
         swap(_write_idx, other._write_idx);
         swap(_alloc_addr, other._alloc_addr);
@@ -206,7 +436,8 @@ private:
                 this->deallocate(_alloc_addr, _alloc_size);
 
             _elements = nullptr;
-            _capacity_plus_one = 1;
+            _capacity = 0;
+            _idx_mask = calc_idx_mask(0);
             _read_idx = 0;
             _write_idx = 0;
             _alloc_addr = nullptr;
@@ -215,19 +446,20 @@ private:
         else
         {
             // Allocate new buffer & Align it
-            std::size_t new_alloc_size = (new_capacity + 1) * sizeof(T) + (alignof(T) - 1);
+            std::size_t new_alloc_size = new_capacity * sizeof(T) + (alignof(T) - 1);
             std::byte* new_alloc_addr = this->allocate(new_alloc_size);
             T* new_elements = reinterpret_cast<T*>(new_alloc_addr);
             std::size_t space = new_alloc_size;
             new_elements = reinterpret_cast<T*>(
-                std::align(alignof(T), sizeof(T) * (new_capacity + 1), reinterpret_cast<void*&>(new_elements), space));
+                std::align(alignof(T), sizeof(T) * new_capacity, reinterpret_cast<void*&>(new_elements), space));
             assert(new_elements);
 
             // Move the existing elements to new buffer
             const std::size_t elem_size = size();
             for (std::size_t new_idx = 0, old_idx = _read_idx; new_idx < elem_size;
                  ++new_idx, old_idx = move_idx(old_idx, +1))
-                ::new (static_cast<void*>(new_elements + new_idx)) T(std::move_if_noexcept(_elements[old_idx]));
+                ::new (static_cast<void*>(new_elements + new_idx))
+                    T(std::move_if_noexcept(_elements[slot_idx(old_idx)]));
 
             // Set position infos
             _read_idx = 0;
@@ -239,22 +471,54 @@ private:
 
             // Set new buffer
             _elements = new_elements;
-            _capacity_plus_one = new_capacity + 1;
+            _capacity = new_capacity;
+            _idx_mask = calc_idx_mask(new_capacity);
             _alloc_addr = new_alloc_addr;
             _alloc_size = new_alloc_size;
         }
     }
 
 private:
+    /// @param diff must be in range `[-2 * _capacity, 2 * _capacity]`
     auto move_idx(std::size_t idx, std::ptrdiff_t diff) const -> std::size_t
     {
-        return idx = (idx + diff + _capacity_plus_one) % _capacity_plus_one;
+        if (diff < 0)
+            idx += 2 * _capacity;
+
+        return wrap_idx(idx + diff);
+    }
+
+    /// @brief Wrap a read/write index into `[0, 2 * _capacity)`
+    /// @param idx must be less than `4 * _capacity`
+    auto wrap_idx(std::size_t idx) const -> std::size_t
+    {
+        if (_idx_mask)
+            return idx & _idx_mask;
+
+        return (idx >= 2 * _capacity) ? idx - 2 * _capacity : idx;
+    }
+
+    /// @brief Convert a read/write index to the slot in `_elements` it refers to
+    /// @param idx must be less than `2 * _capacity`
+    auto slot_idx(std::size_t idx) const -> std::size_t
+    {
+        if (_idx_mask)
+            return idx & (_idx_mask >> 1);
+
+        return (idx >= _capacity) ? idx - _capacity : idx;
+    }
+
+    /// @return bit mask to wrap a read/write index, or `0` if `capacity` is not a power of two
+    static auto calc_idx_mask(std::size_t capacity) -> std::size_t
+    {
+        return std::has_single_bit(capacity) ? 2 * capacity - 1 : 0;
     }
 
 private:
     T* _elements;
 
-    std::size_t _capacity_plus_one;
+    std::size_t _capacity;
+    std::size_t _idx_mask;
     std::size_t _read_idx;
     std::size_t _write_idx;
 
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "NetBuff/SchemaCodec_fwd.hpp"
+
+#include "NetBuff/SerializeInterface.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace nb
+{
+
+/// The generated code packs the consecutive fixed-size fields to a local array with `store()`,
+/// and writes it at once, so that the bounds check is done once per run of them. (Reading is vice versa)
+///
+/// Numbers are stored as little-endian, same as `SerializeBuffer`.
+/// `bool` is stored as 1 byte.
+///
+/// `Buffer` can be any of `SerializeBuffer`, `SerializeWriter` (encode only) and `SerializeReader` (decode only).
+class SchemaCodec
+{
+public:
+    /// @brief Type to store the number of elements of a variable-size array.
+    using CountType = std::uint32_t;
+
+public:
+    template <typename Num>
+        requires std::is_arithmetic_v<Num>
+    static void store(std::byte* dest, Num value)
+    {
+        if constexpr (std::is_same_v<Num, bool>)
+        {
+            *dest = static_cast<std::byte>(value ? 1 : 0);
+        }
+        else
+        {
+            auto bytes = std::bit_cast<std::array<std::byte, sizeof(Num)>>(value);
+            if constexpr (std::endian::native == std::endian::big)
+                std::ranges::reverse(bytes);
+
+            std::memcpy(dest, bytes.data(), sizeof(Num));
+        }
+    }
+
+    template <typename Num>
+        requires std::is_arithmetic_v<Num>
+    static auto load(const std::byte* src) -> Num
+    {
+        if constexpr (std::is_same_v<Num, bool>)
+        {
+            return *src != std::byte(0);
+        }
+        else
+        {
+            std::array<std::byte, sizeof(Num)> bytes;
+            std::memcpy(bytes.data(), src, sizeof(Num));
+            if constexpr (std::endian::native == std::endian::big)
+                std::ranges::reverse(bytes);
+
+            return std::bit_cast<Num>(bytes);
+        }
+    }
+
+public:
+    template <typename Buffer>
+    static bool try_write_count(Buffer& buf, std::size_t count)
+    {
+        if (count > std::numeric_limits<CountType>::max())
+            return fail(buf);
+
+        return buf.try_write(static_cast<CountType>(count));
+    }
+
+    /// @brief Read the number of elements, each of which is at least `min_element_size` bytes.
+    ///
+    /// Fails if the elements can't be in `buf`, to prevent allocating a huge array from a malformed message.
+    template <typename Buffer>
+    static bool try_read_count(Buffer& buf, std::size_t& count, std::size_t min_element_size)
+    {
+        CountType count_read;
+        if (!buf.try_read(count_read))
+            return false;
+
+        if (static_cast<std::uint64_t>(count_read) * min_element_size > buf.used_space())
+            return fail(buf);
+
+        count = count_read;
+        return true;
+    }
+
+    /// @brief Write the number of elements, and then the elements of an array of numbers at once.
+    template <typename Buffer, typename Num>
+        requires std::is_arithmetic_v<Num> && (!std::is_same_v<Num, bool>)
+    static bool try_write_vector(Buffer& buf, const std::vector<Num>& vec)
+    {
+        if (vec.size() > std::numeric_limits<CountType>::max() ||
+            sizeof(CountType) + vec.size() * sizeof(Num) > buf.available_space())
+            return fail(buf);
+
+        [[maybe_unused]] bool result = buf.try_write(static_cast<CountType>(vec.size()));
+        assert(result);
+
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            if (!vec.empty())
+                result = buf.try_write(vec.data(), vec.size() * sizeof(Num));
+        }
+        else
+        {
+            for (const Num value : vec)
+                result = buf.try_write(value);
+        }
+        assert(result);
+
+        return true;
+    }
+
+    /// @brief Read the number of elements, and then the elements of an array of numbers at once.
+    template <typename Buffer, typename Num>
+        requires std::is_arithmetic_v<Num> && (!std::is_same_v<Num, bool>)
+    static bool try_read_vector(Buffer& buf, std::vector<Num>& vec)
+    {
+        std::size_t count;
+        if (!try_read_count(buf, count, sizeof(Num)))
+            return false;
+
+        vec.resize(count);
+
+        [[maybe_unused]] bool result = true;
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            if (count != 0)
+                result = buf.try_read(vec.data(), count * sizeof(Num));
+        }
+        else
+        {
+            for (Num& value : vec)
+                result = buf.try_read(value);
+        }
+        assert(result);
+
+        return true;
+    }
+
+private:
+    /// @brief Set the fail bit of `buf`, for a read or write which can't be done.
+    template <typename Buffer>
+    static bool fail(Buffer& buf)
+    {
+        buf.set_fail();
+        return false;
+    }
+};
+
+} // namespace nb
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace nb
+{
+
+/// @brief Helpers for the encode & decode functions generated by `nb_schemac`.
+class SchemaCodec;
+
+} // namespace nb
@@ -2,36 +2,86 @@
 
 #include "NetBuff/SerializeBuffer_fwd.hpp"
 
+#include "NetBuff/SerializeInterface.hpp"
+
 #include <algorithm>
 #include <bit>
 #include <cassert>
 #include <cstddef>
-#include <cstdint>
 #include <cstring>
+#include <limits>
 #include <memory>
-#include <string>
-#include <string_view>
 #include <type_traits>
 
 namespace nb
 {
 
-template <typename T>
-concept UnsignedInteger = std::is_same_v<T, std::uint8_t> || std::is_same_v<T, std::uint16_t> ||
-                          std::is_same_v<T, std::uint32_t> || std::is_same_v<T, std::uint64_t>;
+template <std::size_t InlineCapacity>
+class SerializeBufferInlineStorage
+{
+protected:
+    auto inline_buffer() -> std::byte*
+    {
+        return _inline_buffer;
+    }
+
+    auto inline_buffer() const -> const std::byte*
+    {
+        return _inline_buffer;
+    }
+
+private:
+    std::byte _inline_buffer[InlineCapacity];
+};
+
+template <>
+class SerializeBufferInlineStorage<0>
+{
+protected:
+    auto inline_buffer() -> std::byte*
+    {
+        return nullptr;
+    }
 
-template <typename T>
-concept Character = std::is_same_v<T, char> || std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t> ||
-                    std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
+    auto inline_buffer() const -> const std::byte*
+    {
+        return nullptr;
+    }
+};
 
-template <typename T>
-concept String = std::is_same_v<T, std::basic_string<typename T::value_type>>;
+/// @brief Handle to a fixed-width `Num` placeholder, reserved via `SerializeBuffer::try_reserve()`.
+///
+/// It's invalidated if the buffer is resized, cleared, or the placeholder is read.
+template <UnsignedInteger Num>
+struct SerializeSlot
+{
+    using value_type = Num;
 
-template <typename T>
-concept StringView = std::is_same_v<T, std::basic_string_view<typename T::value_type>>;
+    std::size_t pos;
 
-template <typename T>
-concept StringOrStringView = String<T> || StringView<T>;
+    /// @brief Position right after the placeholder.
+    auto end_pos() const -> std::size_t
+    {
+        return pos + sizeof(Num);
+    }
+};
+
+/// @brief Handle to a max-width varint placeholder, reserved via `SerializeBuffer::try_reserve_varint()`.
+///
+/// It's invalidated if the buffer is resized, cleared, or the placeholder is read.
+template <UnsignedInteger Num>
+struct SerializeVarintSlot
+{
+    using value_type = Num;
+
+    std::size_t pos;
+
+    /// @brief Position right after the placeholder.
+    auto end_pos() const -> std::size_t
+    {
+        return pos + varint_max_size<Num>();
+    }
+};
 
 /// @brief Buffer to serialize your message to a byte stream.
 ///
@@ -42,22 +92,35 @@ concept StringOrStringView = String<T> || StringView<T>;
 /// You need to resize it manually via `try_resize()`.
 ///
 /// If you want to reuse an object of this class, you must call `clear()` to reset its positions to `0`.
-template <typename ByteAllocator>
-class SerializeBuffer : private ByteAllocator
+///
+/// @tparam InlineCapacity If the requested capacity is same or less than this,
+/// the data is stored inside the object itself, without calling the allocator.
+template <typename ByteAllocator, std::size_t InlineCapacity>
+class SerializeBuffer : public SerializeInterface<SerializeBuffer<ByteAllocator, InlineCapacity>>,
+                        private ByteAllocator,
+                        private SerializeBufferInlineStorage<InlineCapacity>
 {
     static_assert(std::is_same_v<std::byte, typename ByteAllocator::value_type>);
 
+private:
+    using Interface = SerializeInterface<SerializeBuffer>;
+
 public:
-    using DefaultStringLengthType = std::uint32_t;
+    using typename Interface::DefaultStringLengthType;
+
+    using Interface::try_peek;
+    using Interface::try_read;
+    using Interface::try_write;
 
 public:
     SerializeBuffer() : SerializeBuffer(0)
     {
     }
 
+    /// @param capacity If this is same or less than `InlineCapacity`, the capacity becomes `InlineCapacity`.
     SerializeBuffer(std::size_t capacity)
-        : _buffer(capacity == 0 ? nullptr : this->allocate(capacity)), _capacity(capacity), _pos_read(0), _pos_write(0),
-          _fail(false)
+        : _buffer(capacity <= InlineCapacity ? this->inline_buffer() : this->allocate(capacity)),
+          _capacity(capacity <= InlineCapacity ? InlineCapacity : capacity), _pos_read(0), _pos_write(0)
     {
     }
 
@@ -78,33 +141,16 @@ public:
 public:
     ~SerializeBuffer()
     {
-        if (_buffer)
+        if (_buffer && !is_inline())
             this->deallocate(_buffer, _capacity);
     }
 
-public:
-    /// @brief Check if read/write was failed once or more.
-    ///
-    /// Fail bit is never cleared unless `clear()` is called.
-    bool fail() const
-    {
-        return _fail;
-    }
-
-    /// @brief Check if read/write was not failed at all.
-    ///
-    /// Fail bit is never cleared unless `clear()` is called.
-    operator bool() const
-    {
-        return !fail();
-    }
-
 public:
     bool try_write(const void* data, std::size_t length)
     {
         if (length > available_space())
         {
-            _fail = true;
+            this->_fail = true;
             return false;
         }
 
@@ -127,7 +173,7 @@ public:
     {
         if (length > used_space())
         {
-            _fail = true;
+            this->_fail = true;
             return false;
         }
 
@@ -137,234 +183,108 @@ public:
     }
 
 public:
-    static_assert(std::endian::native == std::endian::little || std::endian::native == std::endian::big,
-                  "Mixed endian system is not supported");
-
-    /// @brief Write a `Num` data, with converting it to little-endian.
-    template <typename Num>
-        requires std::is_arithmetic_v<Num>
-    bool try_write(Num data)
-    {
-        if constexpr (std::endian::native == std::endian::big)
-            data = byteswap(data);
-
-        return try_write(&data, sizeof(data));
-    }
-
-    /// @brief Write a `Num` data, with converting it to little-endian.
-    template <typename Num>
-        requires std::is_arithmetic_v<Num>
-    auto operator<<(Num data) -> SerializeBuffer&
-    {
-        try_write<Num>(data);
-        return *this;
-    }
-
-    /// @brief Read a `Num` data, with converting it to little-endian.
-    template <typename Num>
-        requires std::is_arithmetic_v<Num>
-    bool try_read(Num& data)
+    /// @tparam StringLengthType Which type to use to store the length of the string (u8, u16, u32, u64)
+    template <String Str, UnsignedInteger StringLengthType = DefaultStringLengthType>
+    bool try_peek(Str& str) const
     {
-        const bool result = try_read(&data, sizeof(data));
-
-        if constexpr (std::endian::native == std::endian::big)
-        {
-            if (result)
-                data = byteswap(data);
-        }
+        const auto prev_pos = _pos_read;
 
-        return result;
-    }
+        if (!const_cast<SerializeBuffer*>(this)->template try_read<Str, StringLengthType>(str))
+            return false;
 
-    /// @brief Read a `Num` data, with converting it to little-endian.
-    template <typename Num>
-        requires std::is_arithmetic_v<Num>
-    auto operator>>(Num& data) -> SerializeBuffer&
-    {
-        try_read<Num>(data);
-        return *this;
+        const_cast<SerializeBuffer*>(this)->_pos_read = prev_pos;
+        return true;
     }
 
-    /// @brief Peek a `Num` data, with converting it to little-endian.
-    template <typename Num>
-        requires std::is_arithmetic_v<Num>
-    bool try_peek(Num& data) const
+    template <Character Char, UnsignedInteger StringLengthType = DefaultStringLengthType>
+    bool try_peek(Char* null_terminated_str) const
     {
-        const bool result = try_peek(&data, sizeof(data));
+        const auto prev_pos = _pos_read;
 
-        if constexpr (std::endian::native == std::endian::big)
-        {
-            if (result)
-                data = byteswap(data);
-        }
+        if (!const_cast<SerializeBuffer*>(this)->template try_read<Char, StringLengthType>(null_terminated_str))
+            return false;
 
-        return result;
+        const_cast<SerializeBuffer*>(this)->_pos_read = prev_pos;
+        return true;
     }
 
 public:
-    /// @tparam StringLengthType Which type to use to store the length of the string (u8, u16, u32, u64)
-    template <StringOrStringView Str, UnsignedInteger StringLengthType = DefaultStringLengthType>
-    bool try_write(const Str& str)
+    /// @brief Reserve a placeholder for a `Num`, to be written later via `patch()`.
+    ///
+    /// This is useful for length prefixes, which is not known until the payload is written.
+    template <UnsignedInteger Num>
+    bool try_reserve(SerializeSlot<Num>& slot)
     {
-        const auto str_bytes = str.length() * sizeof(typename Str::value_type);
-        if (sizeof(StringLengthType) + str_bytes > available_space())
+        if (sizeof(Num) > available_space())
         {
-            _fail = true;
+            this->_fail = true;
             return false;
         }
 
-        // write length of `str`
-        [[maybe_unused]] bool result = try_write(static_cast<StringLengthType>(str.length()));
-        assert(result);
-
-        // only `std::u16string` & `std::u32string` are converted to little-endian
-        if constexpr ((std::is_same_v<Str, std::u16string> || std::is_same_v<Str, std::u16string_view> ||
-                       std::is_same_v<Str, std::u32string> || std::is_same_v<Str, std::u32string_view>) &&
-                      std::endian::native == std::endian::big)
-        {
-            for (auto ch : str)
-            {
-                result = try_write(ch); // byteswap inside
-                assert(result);
-            }
-        }
-        else
-        {
-            result = try_write(str.data(), str_bytes);
-            assert(result);
-        }
+        slot.pos = _pos_write;
+        std::memset(_buffer + _pos_write, 0, sizeof(Num));
+        move_write_pos(sizeof(Num));
 
         return true;
     }
 
-    template <StringOrStringView Str>
-    auto operator<<(const Str& str) -> SerializeBuffer&
-    {
-        try_write<Str>(str);
-        return *this;
-    }
-
-    /// @tparam StringLengthType Which type to use to store the length of the string (u8, u16, u32, u64)
-    template <String Str, UnsignedInteger StringLengthType = DefaultStringLengthType>
-    bool try_read(Str& str)
+    /// @brief Reserve a placeholder for a varint `Num`, to be written later via `patch()`.
+    ///
+    /// As the value is not known yet, `varint_max_size<Num>()` bytes are reserved,
+    /// and the value is patched as a padded varint, which `try_read_varint()` can read.
+    template <UnsignedInteger Num>
+    bool try_reserve_varint(SerializeVarintSlot<Num>& slot)
     {
-        // read length of `str`
-        StringLengthType length;
-        if (!try_peek(length))
-            return false;
+        constexpr std::size_t SLOT_SIZE = varint_max_size<Num>();
 
-        // check if valid length of payload exists
-        const auto payload_bytes = length * sizeof(typename Str::value_type);
-        if (sizeof(StringLengthType) + payload_bytes > used_space())
+        if (SLOT_SIZE > available_space())
         {
-            _fail = true;
+            this->_fail = true;
             return false;
         }
 
-        _pos_read += sizeof(StringLengthType);
-
-        // only `std::u16string` & `std::u32string` are converted to little-endian
-        if constexpr ((std::is_same_v<Str, std::u16string> || std::is_same_v<Str, std::u16string_view> ||
-                       std::is_same_v<Str, std::u32string> || std::is_same_v<Str, std::u32string_view>) &&
-                      std::endian::native == std::endian::big)
-        {
-            str.clear();
-            str.reserve(length);
-
-            for (std::size_t idx = 0; idx < length; ++idx)
-            {
-                typename Str::value_type ch;
-                [[maybe_unused]] const bool result = try_read(ch); // byteswap inside
-                assert(result);
-
-                str.push_back(ch);
-            }
-        }
-        else
-        {
-            str.resize(length);
-
-            [[maybe_unused]] const bool result = try_read(reinterpret_cast<std::byte*>(str.data()), payload_bytes);
-            assert(result);
-        }
+        slot.pos = _pos_write;
+        Interface::encode_varint(Num(0), _buffer + _pos_write, SLOT_SIZE);
+        move_write_pos(SLOT_SIZE);
 
         return true;
     }
 
-    template <String Str>
-    auto operator>>(Str& str) -> SerializeBuffer&
+    /// @brief Write `data` to the placeholder, with converting it to little-endian.
+    template <UnsignedInteger Num>
+    void patch(const SerializeSlot<Num>& slot, Num data)
     {
-        try_read<Str>(str);
-        return *this;
-    }
-
-    /// @tparam StringLengthType Which type to use to store the length of the string (u8, u16, u32, u64)
-    template <String Str, UnsignedInteger StringLengthType = DefaultStringLengthType>
-    bool try_peek(Str& str) const
-    {
-        const auto prev_pos = _pos_read;
-
-        if (!const_cast<SerializeBuffer*>(this)->try_read(str))
-            return false;
+        assert(_pos_read <= slot.pos && slot.end_pos() <= _pos_write);
 
-        const_cast<SerializeBuffer*>(this)->_pos_read = prev_pos;
-        return true;
-    }
+        if constexpr (std::endian::native == std::endian::big)
+            data = Interface::byteswap(data);
 
-public:
-    template <Character Char, UnsignedInteger StringLengthType = DefaultStringLengthType>
-    bool try_write(const Char* null_terminated_str)
-    {
-        return try_write(std::basic_string_view<Char>(null_terminated_str));
+        std::memcpy(_buffer + slot.pos, &data, sizeof(data));
     }
 
-    template <Character Char>
-    auto operator<<(const Char* null_terminated_str) -> SerializeBuffer&
+    /// @brief Write `data` to the placeholder as a padded varint.
+    template <UnsignedInteger Num>
+    void patch(const SerializeVarintSlot<Num>& slot, Num data)
     {
-        try_write<Char>(null_terminated_str);
-        return *this;
-    }
+        assert(_pos_read <= slot.pos && slot.end_pos() <= _pos_write);
 
-    template <Character Char, UnsignedInteger StringLengthType = DefaultStringLengthType>
-    bool try_read(Char* null_terminated_str)
-    {
-        // read length of `str`
-        StringLengthType length;
-        if (!try_peek(length))
-            return false;
-
-        const auto payload_bytes = length * sizeof(Char);
-        if (sizeof(StringLengthType) + payload_bytes > used_space())
-        {
-            _fail = true;
-            return false;
-        }
-
-        std::memcpy(null_terminated_str, _buffer + _pos_read + sizeof(StringLengthType), length * sizeof(Char));
-        null_terminated_str[length] = Char{};
-
-        _pos_read += sizeof(StringLengthType) + payload_bytes;
-
-        return true;
+        Interface::encode_varint(data, _buffer + slot.pos, varint_max_size<Num>());
     }
 
-    template <Character Char>
-    auto operator>>(Char* null_terminated_str) -> SerializeBuffer&
+    /// @brief Write the number of bytes written after the placeholder to it.
+    ///
+    /// @return `false` if the length doesn't fit in `Num`. (Fail bit is set)
+    template <UnsignedInteger Num>
+    bool try_patch_length(const SerializeSlot<Num>& slot)
     {
-        try_read<Char>(null_terminated_str);
-        return *this;
+        return try_patch_length_impl(slot);
     }
 
-    template <Character Char, UnsignedInteger StringLengthType = DefaultStringLengthType>
-    bool try_peek(Char* null_terminated_str) const
+    /// @brief Write the number of bytes written after the placeholder to it.
+    template <UnsignedInteger Num>
+    bool try_patch_length(const SerializeVarintSlot<Num>& slot)
     {
-        const auto prev_pos = _pos_read;
-
-        if (!const_cast<SerializeBuffer*>(this)->try_read(null_terminated_str))
-            return false;
-
-        const_cast<SerializeBuffer*>(this)->_pos_read = prev_pos;
-        return true;
+        return try_patch_length_impl(slot);
     }
 
 public:
@@ -372,7 +292,7 @@ public:
     {
         _pos_read = 0;
         _pos_write = 0;
-        _fail = false;
+        this->_fail = false;
     }
 
     /// @brief Try resizing the buffer.
@@ -408,11 +328,42 @@ public:
         if constexpr (std::allocator_traits<ByteAllocator>::propagate_on_container_swap::value)
             swap<ByteAllocator>(*this, other);
 
-        swap(_buffer, other._buffer);
+        if constexpr (InlineCapacity != 0)
+        {
+            const bool this_inline = is_inline();
+            const bool other_inline = other.is_inline();
+
+            // inline data can't be swapped by its pointer, so swap the contents instead
+            if (this_inline && other_inline)
+            {
+                std::swap_ranges(this->inline_buffer(), this->inline_buffer() + InlineCapacity, other.inline_buffer());
+            }
+            else if (this_inline)
+            {
+                std::memcpy(other.inline_buffer(), this->inline_buffer(), InlineCapacity);
+                _buffer = other._buffer;
+                other._buffer = other.inline_buffer();
+            }
+            else if (other_inline)
+            {
+                std::memcpy(this->inline_buffer(), other.inline_buffer(), InlineCapacity);
+                other._buffer = _buffer;
+                _buffer = this->inline_buffer();
+            }
+            else
+            {
+                swap(_buffer, other._buffer);
+            }
+        }
+        else
+        {
+            swap(_buffer, other._buffer);
+        }
+
         swap(_capacity, other._capacity);
         swap(_pos_read, other._pos_read);
         swap(_pos_write, other._pos_write);
-        swap(_fail, other._fail);
+        swap(this->_fail, other._fail);
     }
 
 public:
@@ -421,6 +372,20 @@ public:
         return _capacity;
     }
 
+    static constexpr auto inline_capacity() -> std::size_t
+    {
+        return InlineCapacity;
+    }
+
+    /// @brief Checks if the data is stored inside the object itself. (i.e. Not allocated via `ByteAllocator`)
+    bool is_inline() const
+    {
+        if constexpr (InlineCapacity == 0)
+            return false;
+        else
+            return _buffer == this->inline_buffer();
+    }
+
 public:
     /// @brief Checks if the buffer is empty.
     ///
@@ -485,34 +450,42 @@ public:
         _pos_write += diff;
     }
 
+private:
+    template <typename Slot>
+    bool try_patch_length_impl(const Slot& slot)
+    {
+        using Num = typename Slot::value_type;
+
+        const std::size_t length = _pos_write - slot.end_pos();
+        if (length > std::numeric_limits<Num>::max())
+        {
+            this->_fail = true;
+            return false;
+        }
+
+        patch(slot, static_cast<Num>(length));
+        return true;
+    }
+
 private:
     void resize(std::size_t new_capacity)
     {
         const std::size_t used = used_space();
+        const bool to_inline = (new_capacity <= InlineCapacity);
 
-        std::byte* new_buffer = (new_capacity == 0) ? nullptr : this->allocate(new_capacity);
+        std::byte* new_buffer = to_inline ? this->inline_buffer() : this->allocate(new_capacity);
 
+        // `memmove()`, as inline buffer can be moved to itself
         if (new_buffer && !empty())
-            std::memcpy(new_buffer, _buffer + _pos_read, used);
+            std::memmove(new_buffer, _buffer + _pos_read, used);
 
         _pos_read = 0;
         _pos_write = used;
 
-        if (_buffer)
+        if (_buffer && !is_inline())
             this->deallocate(_buffer, _capacity);
         _buffer = new_buffer;
-        _capacity = new_capacity;
-    }
-
-private:
-    template <typename Num>
-        requires std::is_arithmetic_v<Num>
-    static Num byteswap(Num value) noexcept
-    {
-        static_assert(std::has_unique_object_representations_v<Num>, "`Num` may not have padding bits");
-        auto value_representation = std::bit_cast<std::array<std::byte, sizeof(Num)>>(value);
-        std::ranges::reverse(value_representation);
-        return std::bit_cast<Num>(value_representation);
+        _capacity = to_inline ? InlineCapacity : new_capacity;
     }
 
 private:
@@ -521,8 +494,6 @@ private:
 
     std::size_t _pos_read;
     std::size_t _pos_write;
-
-    mutable bool _fail;
 };
 
 } // namespace nb
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "NetBuff/SerializeBufferPool_fwd.hpp"
+
+#include "NetBuff/ObjectPool.hpp"
+#include "NetBuff/SerializeBuffer.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+namespace nb
+{
+
+template <typename ByteAllocator>
+class SerializeBufferPool final
+{
+public:
+    using Buffer = SerializeBuffer<ByteAllocator>;
+
+    static constexpr std::array<std::size_t, 4> SIZE_CLASSES = {256, 1024, 4096, 64 * 1024};
+    static constexpr std::size_t SIZE_CLASS_COUNT = SIZE_CLASSES.size();
+
+    /// @brief Size class index for the buffers larger than `SIZE_CLASSES.back()`
+    static constexpr std::size_t OVERSIZED = SIZE_CLASS_COUNT;
+
+    struct Stats
+    {
+        std::size_t hits = 0;   // `acquire()` reused a cached buffer
+        std::size_t misses = 0; // `acquire()` allocated a new buffer
+    };
+
+    /// @brief Buffer handed out by `acquire()`.
+    ///
+    /// It remembers its pool & size class, to return it to the right pool on `release()`.
+    /// Only the pool can construct it, so `release()` doesn't accept a plain `Buffer`.
+    class PooledBuffer final : public Buffer
+    {
+    private:
+        template <typename T, bool CallDestructorOnDestroy, typename Allocator>
+        friend class ObjectPool;
+
+        PooledBuffer(const SerializeBufferPool* owner, std::size_t size_class, std::size_t capacity)
+            : Buffer(capacity), _owner(owner), _size_class(size_class)
+        {
+        }
+
+    public:
+        auto size_class() const -> std::size_t
+        {
+            return _size_class;
+        }
+
+        /// @return the pool that this buffer must be returned to
+        auto owner() const -> const SerializeBufferPool*
+        {
+            return _owner;
+        }
+
+    private:
+        const SerializeBufferPool* _owner;
+        std::size_t _size_class;
+    };
+
+public:
+    SerializeBufferPool() = default;
+
+    SerializeBufferPool(const SerializeBufferPool&) = delete;
+    SerializeBufferPool& operator=(const SerializeBufferPool&) = delete;
+
+    SerializeBufferPool(SerializeBufferPool&&) = delete;
+    SerializeBufferPool& operator=(SerializeBufferPool&&) = delete;
+
+public:
+    /// @brief Get an empty buffer with at least `capacity` bytes.
+    ///
+    /// You MUST return it via `release()` of this pool.
+    [[nodiscard]] auto acquire(std::size_t capacity) -> PooledBuffer&
+    {
+        const std::size_t size_class = size_class_of(capacity);
+
+        if (size_class == OVERSIZED)
+        {
+            ++_stats[OVERSIZED].misses;
+            return _oversized_pool.construct(this, OVERSIZED, capacity);
+        }
+
+        if (_cached_counts[size_class] > 0)
+        {
+            --_cached_counts[size_class];
+            ++_stats[size_class].hits;
+        }
+        else
+        {
+            ++_stats[size_class].misses;
+        }
+
+        // cached buffer ignores the constructor arguments
+        PooledBuffer& buf = _pools[size_class].construct(this, size_class, SIZE_CLASSES[size_class]);
+        assert(buf.owner() == this && buf.size_class() == size_class);
+        assert(buf.empty() && !buf.fail());
+
+        // user might have shrinked it before `release()`
+        [[maybe_unused]] const bool result = buf.try_resize(SIZE_CLASSES[size_class]);
+        assert(result);
+
+        return buf;
+    }
+
+    /// @brief Return the buffer that was acquired from this pool.
+    ///
+    /// If the user grew it beyond its size class, it's shrinked back before caching,
+    /// so that a single large message doesn't pin its storage in the pool.
+    void release(PooledBuffer& pooled)
+    {
+        assert(pooled.owner() == this && "buffer was acquired from another pool");
+        const std::size_t size_class = pooled.size_class();
+
+        if (size_class == OVERSIZED)
+        {
+            _oversized_pool.destroy(pooled);
+            return;
+        }
+
+        pooled.clear();
+        if (pooled.capacity() > SIZE_CLASSES[size_class])
+        {
+            pooled.shrink_to_fit();
+            [[maybe_unused]] const bool result = pooled.try_resize(SIZE_CLASSES[size_class]);
+            assert(result);
+        }
+
+        _pools[size_class].destroy(pooled);
+        ++_cached_counts[size_class];
+    }
+
+public:
+    /// @return index of the smallest size class that fits `capacity`, or `OVERSIZED` if nothing fits
+    static constexpr auto size_class_of(std::size_t capacity) -> std::size_t
+    {
+        for (std::size_t idx = 0; idx < SIZE_CLASS_COUNT; ++idx)
+        {
+            if (capacity <= SIZE_CLASSES[idx])
+                return idx;
+        }
+
+        return OVERSIZED;
+    }
+
+    /// @param size_class index of `SIZE_CLASSES`, or `OVERSIZED`
+    auto stats(std::size_t size_class) const -> const Stats&
+    {
+        assert(size_class <= OVERSIZED);
+        return _stats[size_class];
+    }
+
+    auto total_stats() const -> Stats
+    {
+        Stats total;
+        for (const Stats& stats : _stats)
+        {
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+        }
+
+        return total;
+    }
+
+    /// @return number of released buffers that are kept for reuse in `size_class`
+    auto cached_count(std::size_t size_class) const -> std::size_t
+    {
+        assert(size_class < SIZE_CLASS_COUNT);
+        return _cached_counts[size_class];
+    }
+
+    /// @return number of buffers that are not released yet
+    auto used_count() const -> std::size_t
+    {
+        std::size_t used = _oversized_pool.used_slots();
+        for (const auto& pool : _pools)
+            used += pool.used_slots();
+
+        return used;
+    }
+
+private:
+    // Buffers are kept constructed (w/ their storage) after `destroy()`
+    std::array<ObjectPool<PooledBuffer, false, ByteAllocator>, SIZE_CLASS_COUNT> _pools;
+
+    // Buffers are destructed (i.e. their storage is deallocated) on `destroy()`
+    ObjectPool<PooledBuffer, true, ByteAllocator> _oversized_pool;
+
+    std::array<std::size_t, SIZE_CLASS_COUNT> _cached_counts = {};
+    std::array<Stats, SIZE_CLASS_COUNT + 1> _stats = {};
+};
+
+} // namespace nb
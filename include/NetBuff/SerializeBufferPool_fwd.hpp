@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace nb
+{
+
+/// @brief Pool of `SerializeBuffer`s, grouped by capacity size classes.
+///
+/// Returned buffers are cleared and kept for the next `acquire()` of the same size class.
+/// Buffers larger than the biggest size class are not kept; their storage is deallocated on `release()`.
+template <typename ByteAllocator = std::allocator<std::byte>>
+class SerializeBufferPool;
+
+} // namespace nb
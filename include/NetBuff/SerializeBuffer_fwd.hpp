@@ -5,6 +5,10 @@
 
 namespace nb
 {
-template <typename ByteAllocator = std::allocator<std::byte>>
+template <typename ByteAllocator = std::allocator<std::byte>, std::size_t InlineCapacity = 0>
 class SerializeBuffer;
+
+/// @brief `SerializeBuffer` that stores up to `InlineCapacity` bytes inside the object itself.
+template <std::size_t InlineCapacity, typename ByteAllocator = std::allocator<std::byte>>
+using SmallSerializeBuffer = SerializeBuffer<ByteAllocator, InlineCapacity>;
 }
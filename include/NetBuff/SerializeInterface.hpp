@@ -0,0 +1,468 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace nb
+{
+
+template <typename T>
+concept UnsignedInteger = std::is_same_v<T, std::uint8_t> || std::is_same_v<T, std::uint16_t> ||
+                          std::is_same_v<T, std::uint32_t> || std::is_same_v<T, std::uint64_t>;
+
+template <typename T>
+concept Character = std::is_same_v<T, char> || std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t> ||
+                    std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
+
+template <typename T>
+concept String = std::is_same_v<T, std::basic_string<typename T::value_type>>;
+
+template <typename T>
+concept StringView = std::is_same_v<T, std::basic_string_view<typename T::value_type>>;
+
+template <typename T>
+concept StringOrStringView = String<T> || StringView<T>;
+
+/// @brief Maximum bytes of a `Num` encoded as a varint. (LEB128)
+template <UnsignedInteger Num>
+constexpr auto varint_max_size() -> std::size_t
+{
+    return (sizeof(Num) * 8 + 6) / 7;
+}
+
+/// @brief Decode a `Num` encoded as a varint (LEB128) from the first `data_size` bytes of `data`.
+///
+/// Padded (non-minimal) encodings are accepted, as long as they fit in `varint_max_size<Num>()` bytes.
+///
+/// @return Size of the varint, or 0 if it's overflowed or incomplete (`value` is left as is)
+template <UnsignedInteger Num>
+constexpr auto decode_varint(const std::byte* data, std::size_t data_size, Num& value) -> std::size_t
+{
+    constexpr std::size_t MAX_SIZE = varint_max_size<Num>();
+
+    Num result = 0;
+    for (std::size_t idx = 0; idx < std::min(MAX_SIZE, data_size); ++idx)
+    {
+        const auto byte = static_cast<std::uint8_t>(data[idx]);
+        const auto shift = static_cast<unsigned>(7 * idx);
+        const auto bits = static_cast<Num>(byte & 0x7F);
+
+        // bits that don't fit in `Num`
+        if (idx == MAX_SIZE - 1 && (bits >> (sizeof(Num) * 8 - shift)) != 0)
+            return 0;
+
+        result |= static_cast<Num>(bits << shift);
+
+        if (!(byte & 0x80))
+        {
+            value = result;
+            return idx + 1;
+        }
+    }
+
+    return 0;
+}
+
+/// @brief Typed read & write operations (numbers, strings) shared by the serialize buffers.
+///
+/// `Derived` should provide the raw byte operations below, which set `_fail` on failure:
+/// - `bool try_write(const void* data, std::size_t length)`
+/// - `bool try_read(void* dest, std::size_t length)`
+/// - `bool try_peek(void* dest, std::size_t length) const`
+/// - `auto used_space() const -> std::size_t`
+/// - `auto available_space() const -> std::size_t`
+///
+/// As those hide the typed overloads here, `Derived` also needs `using` declarations for them.
+template <typename Derived>
+class SerializeInterface
+{
+public:
+    using DefaultStringLengthType = std::uint32_t;
+
+protected:
+    SerializeInterface() : _fail(false)
+    {
+    }
+
+    /// @brief Set the fail bit, for a failure found outside of the raw byte operations.
+    void set_fail()
+    {
+        _fail = true;
+    }
+
+private:
+    friend class SchemaCodec;
+
+public:
+    /// @brief Check if read/write was failed once or more.
+    ///
+    /// Fail bit is never cleared unless `clear()` is called.
+    bool fail() const
+    {
+        return _fail;
+    }
+
+    /// @brief Check if read/write was not failed at all.
+    ///
+    /// Fail bit is never cleared unless `clear()` is called.
+    operator bool() const
+    {
+        return !fail();
+    }
+
+public:
+    static_assert(std::endian::native == std::endian::little || std::endian::native == std::endian::big,
+                  "Mixed endian system is not supported");
+
+    /// @brief Write a `Num` data, with converting it to little-endian.
+    template <typename Num>
+        requires std::is_arithmetic_v<Num>
+    bool try_write(Num data)
+    {
+        if constexpr (std::endian::native == std::endian::big)
+            data = byteswap(data);
+
+        return derived().try_write(&data, sizeof(data));
+    }
+
+    /// @brief Write a `Num` data, with converting it to little-endian.
+    template <typename Num>
+        requires std::is_arithmetic_v<Num>
+    auto operator<<(Num data) -> Derived&
+    {
+        try_write<Num>(data);
+        return derived();
+    }
+
+    /// @brief Read a `Num` data, with converting it to little-endian.
+    template <typename Num>
+        requires std::is_arithmetic_v<Num>
+    bool try_read(Num& data)
+    {
+        const bool result = derived().try_read(&data, sizeof(data));
+
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            if (result)
+                data = byteswap(data);
+        }
+
+        return result;
+    }
+
+    /// @brief Read a `Num` data, with converting it to little-endian.
+    template <typename Num>
+        requires std::is_arithmetic_v<Num>
+    auto operator>>(Num& data) -> Derived&
+    {
+        try_read<Num>(data);
+        return derived();
+    }
+
+    /// @brief Peek a `Num` data, with converting it to little-endian.
+    template <typename Num>
+        requires std::is_arithmetic_v<Num>
+    bool try_peek(Num& data) const
+    {
+        const bool result = derived().try_peek(&data, sizeof(data));
+
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            if (result)
+                data = byteswap(data);
+        }
+
+        return result;
+    }
+
+public:
+    /// @tparam StringLengthType Which type to use to store the length of the string (u8, u16, u32, u64)
+    template <StringOrStringView Str, UnsignedInteger StringLengthType = DefaultStringLengthType>
+    bool try_write(const Str& str)
+    {
+        const auto str_bytes = str.length() * sizeof(typename Str::value_type);
+        if (sizeof(StringLengthType) + str_bytes > derived().available_space())
+        {
+            _fail = true;
+            return false;
+        }
+
+        // write length of `str`
+        [[maybe_unused]] bool result = try_write(static_cast<StringLengthType>(str.length()));
+        assert(result);
+
+        // only `std::u16string` & `std::u32string` are converted to little-endian
+        if constexpr ((std::is_same_v<Str, std::u16string> || std::is_same_v<Str, std::u16string_view> ||
+                       std::is_same_v<Str, std::u32string> || std::is_same_v<Str, std::u32string_view>) &&
+                      std::endian::native == std::endian::big)
+        {
+            for (auto ch : str)
+            {
+                result = try_write(ch); // byteswap inside
+                assert(result);
+            }
+        }
+        else
+        {
+            result = derived().try_write(str.data(), str_bytes);
+            assert(result);
+        }
+
+        return true;
+    }
+
+    template <StringOrStringView Str>
+    auto operator<<(const Str& str) -> Derived&
+    {
+        try_write<Str>(str);
+        return derived();
+    }
+
+    /// @tparam StringLengthType Which type to use to store the length of the string (u8, u16, u32, u64)
+    template <String Str, UnsignedInteger StringLengthType = DefaultStringLengthType>
+    bool try_read(Str& str)
+    {
+        return try_read<Str, StringLengthType>(str, str.max_size());
+    }
+
+    /// @brief Read a string, which fails if its length is longer than `max_length`.
+    ///
+    /// Hostile lengths are rejected before resizing `str`, so use this on data from untrusted peers.
+    /// @tparam StringLengthType Which type to use to store the length of the string (u8, u16, u32, u64)
+    template <String Str, UnsignedInteger StringLengthType = DefaultStringLengthType>
+    bool try_read(Str& str, std::size_t max_length)
+    {
+        // read length of `str`
+        StringLengthType length;
+        if (!try_peek(length))
+            return false;
+
+        // check if valid length of payload exists
+        if (length > max_length || !payload_available<typename Str::value_type>(length))
+        {
+            _fail = true;
+            return false;
+        }
+
+        [[maybe_unused]] bool result = try_read(length);
+        assert(result);
+
+        // only `std::u16string` & `std::u32string` are converted to little-endian
+        if constexpr ((std::is_same_v<Str, std::u16string> || std::is_same_v<Str, std::u16string_view> ||
+                       std::is_same_v<Str, std::u32string> || std::is_same_v<Str, std::u32string_view>) &&
+                      std::endian::native == std::endian::big)
+        {
+            str.clear();
+            str.reserve(length);
+
+            for (std::size_t idx = 0; idx < length; ++idx)
+            {
+                typename Str::value_type ch;
+                result = try_read(ch); // byteswap inside
+                assert(result);
+
+                str.push_back(ch);
+            }
+        }
+        else
+        {
+            const auto payload_bytes = static_cast<std::size_t>(length) * sizeof(typename Str::value_type);
+            str.resize(length);
+
+            result = derived().try_read(reinterpret_cast<std::byte*>(str.data()), payload_bytes);
+            assert(result);
+        }
+
+        return true;
+    }
+
+    template <String Str>
+    auto operator>>(Str& str) -> Derived&
+    {
+        try_read<Str>(str);
+        return derived();
+    }
+
+public:
+    template <Character Char, UnsignedInteger StringLengthType = DefaultStringLengthType>
+    bool try_write(const Char* null_terminated_str)
+    {
+        return try_write(std::basic_string_view<Char>(null_terminated_str));
+    }
+
+    template <Character Char>
+    auto operator<<(const Char* null_terminated_str) -> Derived&
+    {
+        try_write<Char>(null_terminated_str);
+        return derived();
+    }
+
+    /// @brief Read a string into `null_terminated_str`, which should be large enough to hold it.
+    ///
+    /// As the size of `null_terminated_str` is unknown, prefer the `std::span` overload for untrusted data.
+    template <Character Char, UnsignedInteger StringLengthType = DefaultStringLengthType>
+    bool try_read(Char* null_terminated_str)
+    {
+        // read length of `str`
+        StringLengthType length;
+        if (!try_peek(length))
+            return false;
+
+        if (!payload_available<Char>(length))
+        {
+            _fail = true;
+            return false;
+        }
+
+        return read_c_str_payload(null_terminated_str, length);
+    }
+
+    /// @brief Read a string into `dest`, which fails if it can't hold the string and the null terminator.
+    template <Character Char, std::size_t Extent, UnsignedInteger StringLengthType = DefaultStringLengthType>
+    bool try_read(std::span<Char, Extent> dest)
+    {
+        // read length of `str`
+        StringLengthType length;
+        if (!try_peek(length))
+            return false;
+
+        if (length >= dest.size() || !payload_available<Char>(length))
+        {
+            _fail = true;
+            return false;
+        }
+
+        return read_c_str_payload(dest.data(), length);
+    }
+
+    template <Character Char>
+    auto operator>>(Char* null_terminated_str) -> Derived&
+    {
+        try_read<Char>(null_terminated_str);
+        return derived();
+    }
+
+public:
+    /// @brief Write a `Num` data as a varint. (LEB128)
+    template <UnsignedInteger Num>
+    bool try_write_varint(Num data)
+    {
+        std::array<std::byte, varint_max_size<Num>()> bytes;
+        const std::size_t size = encode_varint(data, bytes.data());
+
+        return derived().try_write(bytes.data(), size);
+    }
+
+    /// @brief Read a `Num` data written as a varint. (LEB128)
+    ///
+    /// Padded (non-minimal) encodings are accepted, as long as they fit in `varint_max_size<Num>()` bytes.
+    /// (See `decode_varint()`)
+    template <UnsignedInteger Num>
+    bool try_read_varint(Num& data)
+    {
+        constexpr std::size_t MAX_SIZE = varint_max_size<Num>();
+
+        std::array<std::byte, MAX_SIZE> bytes;
+        const std::size_t peek_size = std::min(MAX_SIZE, derived().used_space());
+        if (!derived().try_peek(bytes.data(), peek_size))
+            return false;
+
+        const std::size_t varint_size = decode_varint(bytes.data(), peek_size, data);
+        if (varint_size == 0)
+        {
+            // overflowed, or not enough data
+            _fail = true;
+            return false;
+        }
+
+        [[maybe_unused]] const bool result = derived().try_read(bytes.data(), varint_size);
+        assert(result);
+
+        return true;
+    }
+
+private:
+    /// @brief Check if `length` of `Char`s follow the string length in the buffer, without overflowing.
+    ///
+    /// Should be called after the string length is peeked.
+    template <typename Char, UnsignedInteger StringLengthType>
+    bool payload_available(StringLengthType length) const
+    {
+        const std::size_t payload_space = derived().used_space() - sizeof(StringLengthType);
+        return length <= payload_space / sizeof(Char);
+    }
+
+    /// @brief Read the peeked string length and the payload, and then null terminate `dest`.
+    template <Character Char, UnsignedInteger StringLengthType>
+    bool read_c_str_payload(Char* dest, StringLengthType length)
+    {
+        [[maybe_unused]] bool result = try_read(length);
+        assert(result);
+
+        result = derived().try_read(dest, static_cast<std::size_t>(length) * sizeof(Char));
+        assert(result);
+        dest[length] = Char{};
+
+        return true;
+    }
+
+protected:
+    /// @brief Encode `value` as a varint (LEB128) to `dest`, padded to at least `min_size` bytes.
+    ///
+    /// @return Encoded bytes
+    template <UnsignedInteger Num>
+    static auto encode_varint(Num value, std::byte* dest, std::size_t min_size = 1) -> std::size_t
+    {
+        std::size_t size = 0;
+        bool more;
+        do
+        {
+            auto byte = static_cast<std::uint8_t>(value & 0x7F);
+            value = static_cast<Num>(value >> 7);
+            ++size;
+
+            more = (value != 0 || size < min_size);
+            if (more)
+                byte |= 0x80;
+
+            *dest++ = static_cast<std::byte>(byte);
+        } while (more);
+
+        return size;
+    }
+
+protected:
+    template <typename Num>
+        requires std::is_arithmetic_v<Num>
+    static Num byteswap(Num value) noexcept
+    {
+        static_assert(std::has_unique_object_representations_v<Num>, "`Num` may not have padding bits");
+        auto value_representation = std::bit_cast<std::array<std::byte, sizeof(Num)>>(value);
+        std::ranges::reverse(value_representation);
+        return std::bit_cast<Num>(value_representation);
+    }
+
+private:
+    auto derived() -> Derived&
+    {
+        return static_cast<Derived&>(*this);
+    }
+
+    auto derived() const -> const Derived&
+    {
+        return static_cast<const Derived&>(*this);
+    }
+
+protected:
+    mutable bool _fail;
+};
+
+} // namespace nb
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "NetBuff/SerializeReader_fwd.hpp"
+
+#include "NetBuff/RingByteBuffer.hpp"
+#include "NetBuff/SerializeInterface.hpp"
+#include "NetBuff/SpscRingByteBuffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+namespace nb
+{
+
+/// It has the same read operations as `SerializeBuffer`, without copying the data to it first.
+///
+/// The source data is NOT consumed; After reading, move the read position of the source by `read_bytes()`.
+/// e.g. `ring.move_read_pos(reader.read_bytes())`
+class SerializeReader : public SerializeInterface<SerializeReader>
+{
+private:
+    using Interface = SerializeInterface<SerializeReader>;
+
+public:
+    using typename Interface::DefaultStringLengthType;
+
+    using Interface::try_peek;
+    using Interface::try_read;
+
+    // read-only; hide the write operations of `SerializeInterface`
+    template <typename... Args>
+    bool try_write(Args&&...) = delete;
+    template <typename... Args>
+    bool try_write_varint(Args&&...) = delete;
+    template <typename Arg>
+    auto operator<<(Arg&&) -> SerializeReader& = delete;
+
+public:
+    SerializeReader() : SerializeReader(std::span<const std::byte>())
+    {
+    }
+
+    SerializeReader(std::span<const std::byte> data) : SerializeReader(data, std::span<const std::byte>())
+    {
+    }
+
+    /// @brief Read `first`, and then `second` as a consecutive byte stream.
+    SerializeReader(std::span<const std::byte> first, std::span<const std::byte> second)
+        : _first(first), _second(second), _pos_read(0)
+    {
+    }
+
+    /// @brief Read the used space of `ring`.
+    template <typename ByteAllocator>
+    explicit SerializeReader(const RingByteBuffer<ByteAllocator>& ring)
+        : SerializeReader(ring.data(), ring.capacity(), ring.read_pos(), ring.used_space())
+    {
+    }
+
+    /// @brief (Consumer only) Read the readable bytes of `ring`.
+    ///
+    /// The producer may keep writing meanwhile, which is not visible to this reader.
+    template <typename ByteAllocator>
+    explicit SerializeReader(const SpscRingByteBuffer<ByteAllocator>& ring)
+        : SerializeReader(ring.data(), ring.capacity(), ring.read_pos(), ring.available_read())
+    {
+    }
+
+private:
+    /// @param used Snapshot of the used space, which both spans are derived from,
+    /// as loading it again might see more bytes written by the producer.
+    SerializeReader(const std::byte* ring_data, std::size_t ring_capacity, std::size_t read_pos, std::size_t used)
+        : SerializeReader(std::span<const std::byte>(ring_data + read_pos, std::min(ring_capacity - read_pos, used)),
+                          std::span<const std::byte>(ring_data, used - std::min(ring_capacity - read_pos, used)))
+    {
+    }
+
+public:
+    bool try_read(void* dest, std::size_t length)
+    {
+        const bool result = try_peek(dest, length);
+        if (result)
+            move_read_pos(length);
+
+        return result;
+    }
+
+    bool try_peek(void* dest, std::size_t length) const
+    {
+        if (length > used_space())
+        {
+            _fail = true;
+            return false;
+        }
+
+        if (length == 0)
+            return true;
+
+        // 1-phase copy
+        if (_pos_read >= _first.size())
+        {
+            std::memcpy(dest, _second.data() + (_pos_read - _first.size()), length);
+        }
+        else if (length <= _first.size() - _pos_read)
+        {
+            std::memcpy(dest, _first.data() + _pos_read, length);
+        }
+        // 2-phase copy
+        else
+        {
+            const std::size_t len_1 = _first.size() - _pos_read;
+            const std::size_t len_2 = length - len_1;
+
+            std::memcpy(dest, _first.data() + _pos_read, len_1);
+            std::memcpy(static_cast<std::byte*>(dest) + len_1, _second.data(), len_2);
+        }
+
+        return true;
+    }
+
+public:
+    /// @brief Skip all the remaining data, and reset the fail bit.
+    void clear()
+    {
+        _pos_read = _first.size() + _second.size();
+        _fail = false;
+    }
+
+public:
+    bool empty() const
+    {
+        return used_space() == 0;
+    }
+
+    /// @brief Used space (i.e. How many bytes you can read before empty)
+    auto used_space() const -> std::size_t
+    {
+        return _first.size() + _second.size() - _pos_read;
+    }
+
+    /// @brief Nothing can be written to the reader.
+    auto available_space() const -> std::size_t
+    {
+        return 0;
+    }
+
+    /// @brief How many bytes were read so far.
+    auto read_bytes() const -> std::size_t
+    {
+        return _pos_read;
+    }
+
+    // No checks performed - Use with caution!
+    void move_read_pos(std::ptrdiff_t diff)
+    {
+        _pos_read += diff;
+    }
+
+private:
+    std::span<const std::byte> _first;
+    std::span<const std::byte> _second;
+
+    std::size_t _pos_read;
+};
+
+} // namespace nb
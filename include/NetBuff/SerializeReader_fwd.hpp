@@ -0,0 +1,10 @@
+#pragma once
+
+namespace nb
+{
+
+/// @brief Non-owning reader to deserialize your message directly from a byte span,
+/// or from the two wrapped segments of a ring buffer.
+class SerializeReader;
+
+} // namespace nb
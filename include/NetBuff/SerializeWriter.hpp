@@ -0,0 +1,138 @@
+#pragma once
+
+#include "NetBuff/SerializeWriter_fwd.hpp"
+
+#include "NetBuff/RingByteBuffer.hpp"
+#include "NetBuff/SerializeInterface.hpp"
+#include "NetBuff/SpscRingByteBuffer.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+namespace nb
+{
+
+/// It has the same write operations as `SerializeBuffer`, without staging the data in it first.
+///
+/// When writing into a ring buffer, the written data is NOT committed to it;
+/// After writing, move the write position of the ring buffer by `written_bytes()`.
+/// e.g. `ring.move_write_pos(writer.written_bytes())`
+class SerializeWriter : public SerializeInterface<SerializeWriter>
+{
+private:
+    using Interface = SerializeInterface<SerializeWriter>;
+
+public:
+    using typename Interface::DefaultStringLengthType;
+
+    using Interface::try_write;
+
+    // write-only; hide the read operations of `SerializeInterface`
+    template <typename... Args>
+    bool try_read(Args&&...) = delete;
+    template <typename... Args>
+    bool try_peek(Args&&...) const = delete;
+    template <typename... Args>
+    bool try_read_varint(Args&&...) = delete;
+    template <typename Arg>
+    auto operator>>(Arg&&) -> SerializeWriter& = delete;
+
+public:
+    SerializeWriter() : SerializeWriter(std::span<std::byte>())
+    {
+    }
+
+    SerializeWriter(std::span<std::byte> dest) : _dest(dest), _pos_write(0)
+    {
+    }
+
+    /// @brief Write to the consecutive free space of `ring`.
+    template <typename ByteAllocator>
+    explicit SerializeWriter(RingByteBuffer<ByteAllocator>& ring)
+        : SerializeWriter(std::span<std::byte>(ring.data() + ring.write_pos(), ring.consecutive_write_length()))
+    {
+    }
+
+    /// @brief (Producer only) Write to the consecutive free space of `ring`.
+    template <typename ByteAllocator>
+    explicit SerializeWriter(SpscRingByteBuffer<ByteAllocator>& ring)
+        : SerializeWriter(std::span<std::byte>(ring.data() + ring.write_pos(), ring.consecutive_write_length()))
+    {
+    }
+
+public:
+    bool try_write(const void* data, std::size_t length)
+    {
+        if (length > available_space())
+        {
+            _fail = true;
+            return false;
+        }
+
+        std::memcpy(_dest.data() + _pos_write, data, length);
+        _pos_write += length;
+
+        return true;
+    }
+
+public:
+    /// @brief Discard all the written data, and reset the fail bit.
+    void clear()
+    {
+        _pos_write = 0;
+        _fail = false;
+    }
+
+public:
+    bool full() const
+    {
+        return available_space() == 0;
+    }
+
+    /// @brief Used space (i.e. How many bytes were written so far)
+    auto used_space() const -> std::size_t
+    {
+        return _pos_write;
+    }
+
+    /// @brief Available space (i.e. How many bytes you can write before full)
+    auto available_space() const -> std::size_t
+    {
+        return _dest.size() - _pos_write;
+    }
+
+    /// @brief How many bytes were written so far.
+    auto written_bytes() const -> std::size_t
+    {
+        return _pos_write;
+    }
+
+    auto capacity() const -> std::size_t
+    {
+        return _dest.size();
+    }
+
+    auto data() -> std::byte*
+    {
+        return _dest.data();
+    }
+
+    auto data() const -> const std::byte*
+    {
+        return _dest.data();
+    }
+
+    // No checks performed - Use with caution!
+    void move_write_pos(std::ptrdiff_t diff)
+    {
+        _pos_write += diff;
+    }
+
+private:
+    std::span<std::byte> _dest;
+
+    std::size_t _pos_write;
+};
+
+} // namespace nb
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace nb
+{
+
+/// @brief Non-owning writer to serialize your message directly into a caller-provided byte span.
+class SerializeWriter;
+
+} // namespace nb
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "NetBuff/SharedPayload_fwd.hpp"
+
+#include "NetBuff/RingQueue.hpp"
+#include "NetBuff/SerializeBuffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace nb
+{
+
+template <typename Buffer>
+struct SharedPayloadBlock
+{
+    std::atomic<std::size_t> ref_count;
+    Buffer buf; // frozen
+};
+
+template <typename ByteAllocator>
+class SharedPayload : private std::allocator_traits<ByteAllocator>::template rebind_alloc<
+                          SharedPayloadBlock<SerializeBuffer<ByteAllocator>>>
+{
+    static_assert(std::is_same_v<std::byte, typename ByteAllocator::value_type>);
+
+public:
+    using Buffer = SerializeBuffer<ByteAllocator>;
+
+private:
+    using Block = SharedPayloadBlock<Buffer>;
+    using BlockAllocator = typename std::allocator_traits<ByteAllocator>::template rebind_alloc<Block>;
+
+public:
+    SharedPayload() : _block(nullptr)
+    {
+    }
+
+    /// @brief Freeze the `buf` to share its unread data. (i.e. `[read_pos(), write_pos())`)
+    explicit SharedPayload(Buffer&& buf) : _block(std::allocator_traits<BlockAllocator>::allocate(*this, 1))
+    {
+        ::new (static_cast<void*>(_block)) Block{1, std::move(buf)};
+    }
+
+    SharedPayload(const SharedPayload& other) noexcept : BlockAllocator(other), _block(other._block)
+    {
+        // new reference can only be made from an existing one, so no ordering is required
+        if (_block)
+            _block->ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SharedPayload(SharedPayload&& other) noexcept : SharedPayload()
+    {
+        swap(other);
+    }
+
+    // Copy (or move) and swap idiom
+    SharedPayload& operator=(SharedPayload other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+public:
+    ~SharedPayload()
+    {
+        reset();
+    }
+
+public:
+    void reset() noexcept
+    {
+        if (_block)
+        {
+            // the last owner must see every access of the other owners before destroying the buffer
+            if (_block->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                _block->~Block();
+                std::allocator_traits<BlockAllocator>::deallocate(*this, _block, 1);
+            }
+
+            _block = nullptr;
+        }
+    }
+
+    void swap(SharedPayload& other) noexcept
+    {
+        using std::swap;
+
+        if constexpr (std::allocator_traits<BlockAllocator>::propagate_on_container_swap::value)
+            swap<BlockAllocator>(*this, other);
+
+        swap(_block, other._block);
+    }
+
+public:
+    auto data() const -> const std::byte*
+    {
+        return _block ? _block->buf.data() + _block->buf.read_pos() : nullptr;
+    }
+
+    auto size() const -> std::size_t
+    {
+        return _block ? _block->buf.used_space() : 0;
+    }
+
+    auto bytes() const -> std::span<const std::byte>
+    {
+        return std::span<const std::byte>(data(), size());
+    }
+
+    /// @brief Number of `SharedPayload`s sharing the same data. (Monitoring only, if shared between threads)
+    auto use_count() const -> std::size_t
+    {
+        return _block ? _block->ref_count.load(std::memory_order_relaxed) : 0;
+    }
+
+    explicit operator bool() const
+    {
+        return _block;
+    }
+
+private:
+    Block* _block;
+};
+
+template <typename ByteAllocator>
+class SharedPayloadQueue
+{
+public:
+    using Payload = SharedPayload<ByteAllocator>;
+
+public:
+    SharedPayloadQueue() : SharedPayloadQueue(0)
+    {
+    }
+
+    /// @param capacity max number of `SharedPayload`s in the queue
+    SharedPayloadQueue(std::size_t capacity) : _payloads(capacity), _front_offset(0), _pending_bytes(0)
+    {
+    }
+
+public:
+    bool try_push(const Payload& payload)
+    {
+        if (!_payloads.try_push(payload))
+            return false;
+
+        _pending_bytes += payload.size();
+        return true;
+    }
+
+    bool try_push(Payload&& payload)
+    {
+        const std::size_t size = payload.size();
+        if (!_payloads.try_push(std::move(payload)))
+            return false;
+
+        _pending_bytes += size;
+        return true;
+    }
+
+    /// @brief Fill `segments` with the pending bytes, from the oldest payload.
+    ///
+    /// e.g. Convert each of the returned segments to `iovec` and call `writev()`,
+    /// and then call `consume()` with the bytes sent.
+    ///
+    /// @return number of filled segments
+    auto gather(std::span<std::span<const std::byte>> segments) const -> std::size_t
+    {
+        const std::size_t count = std::min(segments.size(), _payloads.size());
+
+        for (std::size_t idx = 0; idx < count; ++idx)
+            segments[idx] = _payloads[idx].bytes();
+
+        // front payload might be partially sent
+        if (count > 0)
+            segments[0] = segments[0].subspan(_front_offset);
+
+        return count;
+    }
+
+    /// @brief Mark `bytes` from the front as sent, and release the fully sent payloads.
+    void consume(std::size_t bytes)
+    {
+        assert(bytes <= _pending_bytes);
+        _pending_bytes -= bytes;
+
+        while (bytes > 0)
+        {
+            assert(!_payloads.empty());
+
+            const std::size_t front_remain = _payloads.front().size() - _front_offset;
+            if (bytes < front_remain)
+            {
+                _front_offset += bytes;
+                break;
+            }
+
+            bytes -= front_remain;
+            _payloads.pop();
+            _front_offset = 0;
+        }
+
+        // drop the empty payloads, which won't be popped otherwise
+        while (!_payloads.empty() && _payloads.front().size() == 0)
+            _payloads.pop();
+    }
+
+    void clear()
+    {
+        while (!_payloads.empty())
+            _payloads.pop();
+
+        _front_offset = 0;
+        _pending_bytes = 0;
+    }
+
+    /// @brief Try resizing the max number of payloads.
+    ///
+    /// @see `RingQueue::try_resize_buffer()`
+    bool try_resize_buffer(std::size_t new_capacity)
+    {
+        return _payloads.try_resize_buffer(new_capacity);
+    }
+
+public:
+    bool empty() const
+    {
+        return _payloads.empty();
+    }
+
+    bool full() const
+    {
+        return _payloads.full();
+    }
+
+    /// @brief Number of payloads in the queue
+    auto size() const -> std::size_t
+    {
+        return _payloads.size();
+    }
+
+    auto capacity() const -> std::size_t
+    {
+        return _payloads.capacity();
+    }
+
+    /// @brief Number of bytes not sent yet
+    auto pending_bytes() const -> std::size_t
+    {
+        return _pending_bytes;
+    }
+
+private:
+    RingQueue<Payload, ByteAllocator> _payloads;
+
+    std::size_t _front_offset; // sent bytes of the front payload
+    std::size_t _pending_bytes;
+};
+
+} // namespace nb
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace nb
+{
+
+/// @brief Immutable, atomically reference-counted byte payload, made from a `SerializeBuffer`.
+///
+/// Copying it only increases the reference count, so one serialized message can be shared by many sessions.
+template <typename ByteAllocator = std::allocator<std::byte>>
+class SharedPayload;
+
+/// @brief Queue of `SharedPayload`s to send, which gathers them for vectored I/O. (e.g. `writev()`, `WSASend()`)
+template <typename ByteAllocator = std::allocator<std::byte>>
+class SharedPayloadQueue;
+
+} // namespace nb
@@ -0,0 +1,302 @@
+#pragma once
+
+#include "NetBuff/TimingWheel_fwd.hpp"
+
+#include "NetBuff/IntrusiveList.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace nb
+{
+
+struct TimingWheelTimer : public TaggedIntrusiveListNode<TimingWheelTimer>
+{
+public:
+    using tick_type = std::uint64_t;
+
+private:
+    template <typename T, std::size_t SlotBits, std::size_t Levels>
+        requires std::is_base_of_v<TimingWheelTimer, T>
+    friend class TimingWheel;
+
+    static constexpr std::uint32_t UNSCHEDULED = std::numeric_limits<std::uint32_t>::max();
+
+public:
+    TimingWheelTimer() = default;
+
+    // Linked to a bucket of a wheel, so it's neither copied nor moved
+    TimingWheelTimer(const TimingWheelTimer&) = delete;
+    TimingWheelTimer& operator=(const TimingWheelTimer&) = delete;
+
+public:
+    bool scheduled() const noexcept
+    {
+        return _bucket != UNSCHEDULED;
+    }
+
+    /// @brief The tick this timer expires at, which is only valid while it's scheduled.
+    auto expiry() const noexcept -> tick_type
+    {
+        return _expiry;
+    }
+
+private:
+    tick_type _expiry = 0;
+    std::uint32_t _bucket = UNSCHEDULED;
+};
+
+/// @brief Hierarchical timing wheel of intrusive timers.
+///
+/// `schedule()`, `cancel()` and `reschedule()` are O(1), as each timer remembers the bucket it's linked to.
+/// `advance()` expires timers bucket by bucket, and cascades timers down to lower levels as time passes.
+/// Ticks are skipped up to the next cascade while the lower levels are empty, so sparse wheels turn fast.
+///
+/// Buckets are stored inline, so nothing is allocated at all.
+/// Timers should outlive their schedules, and a scheduled timer should be cancelled before being destroyed.
+template <typename T, std::size_t SlotBits, std::size_t Levels>
+    requires std::is_base_of_v<TimingWheelTimer, T>
+class TimingWheel
+{
+public:
+    using tick_type = TimingWheelTimer::tick_type;
+    using size_type = std::size_t;
+
+    static constexpr std::size_t SLOTS = std::size_t(1) << SlotBits;
+    static constexpr std::size_t LEVELS = Levels;
+
+    /// @brief Timers farther than this are placed at the end of the wheel, and re-placed as it turns.
+    ///
+    /// With a single level, they're re-placed when that bucket is expired, instead of being expired early.
+    static constexpr tick_type RANGE = tick_type(1) << (SlotBits * Levels);
+
+    static_assert(SlotBits >= 1 && Levels >= 1);
+    static_assert(SlotBits * Levels < 64, "Range of the wheel exceeds `tick_type`");
+    static_assert(SLOTS * Levels < TimingWheelTimer::UNSCHEDULED, "Too many buckets");
+
+private:
+    static constexpr tick_type MASK = SLOTS - 1;
+
+    // tagged, so that timers can be in other `IntrusiveList`s too
+    using Bucket = IntrusiveList<T, true, IntrusiveListBaseHook<TimingWheelTimer>>;
+
+    // timers being expired by `advance()` are moved to this bucket
+    static constexpr std::uint32_t EXPIRING_BUCKET = static_cast<std::uint32_t>(SLOTS * Levels);
+
+public:
+    /// @param now Current tick, timers expiring at or before this are expired on the next `advance()`
+    explicit TimingWheel(tick_type now = 0) : _next(now + 1), _size(0), _level_sizes{}
+    {
+    }
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+public:
+    /// @brief Schedule `timer` to expire at the tick `expiry`.
+    ///
+    /// If `expiry` is already passed, `timer` is expired on the next `advance()`.
+    void schedule(T& timer, tick_type expiry)
+    {
+        assert(!timer.scheduled());
+
+        timer._expiry = expiry;
+        place(timer);
+        ++_size;
+    }
+
+    /// @brief Unschedule `timer` in O(1).
+    ///
+    /// @return `false` if `timer` was not scheduled
+    bool cancel(T& timer)
+    {
+        if (!timer.scheduled())
+            return false;
+
+        if (timer._bucket != EXPIRING_BUCKET)
+            --_level_sizes[timer._bucket / SLOTS];
+
+        _buckets[timer._bucket].erase(timer);
+        timer._bucket = TimingWheelTimer::UNSCHEDULED;
+        --_size;
+
+        return true;
+    }
+
+    /// @brief Schedule `timer` to expire at the tick `expiry`, whether it's scheduled or not.
+    void reschedule(T& timer, tick_type expiry)
+    {
+        cancel(timer);
+        schedule(timer, expiry);
+    }
+
+    /// @brief Turn the wheel up to the tick `now`, and call `on_expire(T&)` for each expired timer.
+    ///
+    /// Timers are unscheduled before `on_expire` is called, so they can be rescheduled or destroyed in it.
+    /// Other timers can be also cancelled in `on_expire`.
+    ///
+    /// If `on_expire` throws, or calls `advance()` again, the rest of the timers expiring at that tick
+    /// are expired first by the next `advance()`.
+    ///
+    /// @return Number of expired timers
+    template <typename OnExpire>
+    auto advance(tick_type now, OnExpire on_expire) -> size_type
+    {
+        // left by a thrown or re-entered `advance()`
+        size_type expired_count = expire_bucket(on_expire);
+
+        while (_next <= now)
+        {
+            // only the scheduled timers count, as the expiring bucket is empty
+            std::size_t lowest_level = 0;
+            while (lowest_level < Levels && _level_sizes[lowest_level] == 0)
+                ++lowest_level;
+
+            // nothing to cascade nor expire: jump to `now`
+            if (lowest_level == Levels)
+            {
+                _next = now + 1;
+                break;
+            }
+
+            // nothing to expire until the next cascade: skip to it
+
+            const tick_type skip_mask = (tick_type(1) << (SlotBits * lowest_level)) - 1;
+            if ((_next & skip_mask) != 0)
+            {
+                _next = std::min(now + 1, (_next | skip_mask) + 1);
+                continue;
+            }
+
+            const auto slot = static_cast<std::size_t>(_next & MASK);
+            if (slot == 0)
+                cascade(1);
+
+            // move the expired bucket out, so that timers rescheduled in `on_expire` don't land on it
+            Bucket& expiring = _buckets[EXPIRING_BUCKET];
+            assert(expiring.empty());
+            expiring.swap(_buckets[slot]);
+            _level_sizes[0] -= expiring.size();
+            for (T& timer : expiring)
+                timer._bucket = EXPIRING_BUCKET;
+
+            ++_next;
+
+            expired_count += expire_bucket(on_expire);
+        }
+
+        return expired_count;
+    }
+
+public:
+    /// @brief The last tick the wheel was advanced to.
+    auto now() const noexcept -> tick_type
+    {
+        return _next - 1;
+    }
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    /// @brief Number of scheduled timers.
+    auto size() const noexcept -> size_type
+    {
+        return _size;
+    }
+
+private:
+    /// @brief Expire the timers in the expiring bucket, whose tick is `_next - 1`.
+    ///
+    /// @return Number of expired timers
+    template <typename OnExpire>
+    auto expire_bucket(OnExpire& on_expire) -> size_type
+    {
+        size_type expired_count = 0;
+
+        Bucket& expiring = _buckets[EXPIRING_BUCKET];
+        while (!expiring.empty())
+        {
+            T& timer = expiring.front();
+            expiring.pop_front();
+
+            // parked in the single level, as it was too far: place it again, now that it might fit
+            if (timer._expiry >= _next)
+            {
+                place(timer);
+                continue;
+            }
+
+            timer._bucket = TimingWheelTimer::UNSCHEDULED;
+            --_size;
+            ++expired_count;
+
+            on_expire(timer);
+        }
+
+        return expired_count;
+    }
+
+    /// @brief Link `timer` to the bucket of its expiry.
+    void place(T& timer)
+    {
+        tick_type expiry = (timer._expiry < _next) ? _next : timer._expiry;
+        tick_type delta = expiry - _next;
+
+        // too far: park it at the end of the wheel, it'll be re-placed on cascades
+        if (delta >= RANGE)
+        {
+            delta = RANGE - 1;
+            expiry = _next + delta;
+        }
+
+        std::size_t level = 0;
+        while (level + 1 < Levels && delta >= (tick_type(1) << (SlotBits * (level + 1))))
+            ++level;
+
+        const auto slot = static_cast<std::size_t>((expiry >> (SlotBits * level)) & MASK);
+        const auto bucket = static_cast<std::uint32_t>(level * SLOTS + slot);
+
+        _buckets[bucket].push_back(timer);
+        timer._bucket = bucket;
+        ++_level_sizes[level];
+    }
+
+    /// @brief Re-place timers in the current bucket of `level` to lower levels, and go up if it wrapped around.
+    void cascade(std::size_t level)
+    {
+        for (; level < Levels; ++level)
+        {
+            const auto slot = static_cast<std::size_t>((_next >> (SlotBits * level)) & MASK);
+
+            Bucket cascading;
+            cascading.swap(_buckets[level * SLOTS + slot]);
+            _level_sizes[level] -= cascading.size();
+
+            while (!cascading.empty())
+            {
+                T& timer = cascading.front();
+                cascading.pop_front();
+                place(timer);
+            }
+
+            if (slot != 0)
+                break;
+        }
+    }
+
+private:
+    // `Levels` levels of `SLOTS` buckets, and then a bucket of expiring timers
+    std::array<Bucket, SLOTS * Levels + 1> _buckets;
+
+    tick_type _next; // next tick to process
+    size_type _size;
+    std::array<size_type, Levels> _level_sizes; // scheduled timers in each level
+};
+
+} // namespace nb
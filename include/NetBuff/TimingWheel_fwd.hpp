@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace nb
+{
+
+// Your custom timer type `T` should inherit this to be scheduled on `TimingWheel<T>`
+struct TimingWheelTimer;
+
+/// @brief Hierarchical timing wheel of intrusive timers.
+///
+/// @tparam SlotBits Each level has `2^SlotBits` slots
+/// @tparam Levels Number of levels, timers up to `2^(SlotBits * Levels)` ticks away are placed exactly
+template <typename T, std::size_t SlotBits = 8, std::size_t Levels = 4>
+    requires std::is_base_of_v<TimingWheelTimer, T>
+class TimingWheel;
+
+} // namespace nb
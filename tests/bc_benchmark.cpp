@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include "NetBuff/BlockCompressor.hpp"
+#include "NetBuff/SerializeBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t DATA_SIZE = 64 * 1024;
+
+constexpr std::string_view CHAT_WORDS[] = {
+    "hello", "gg",    "wp",     "anyone", "want", "to",   "trade", "sword", "for", "shield", "lol",
+    "where", "is",    "the",    "boss",   "meet", "at",   "town",  "gate",  "ok",  "brb",    "need",
+    "heal",  "party", "invite", "me",     "pls",  "nice", "drop",  "!",     "?",   "thanks",
+};
+
+/// @brief Snapshot of the entities, which have a few fields changing.
+auto make_snapshot() -> nb::SerializeBuffer<>
+{
+    std::mt19937 rng(42);
+    nb::SerializeBuffer<> buf(DATA_SIZE);
+
+    for (std::uint32_t id = 0; buf.available_space() >= 48; ++id)
+    {
+        const auto x = static_cast<float>(rng() % 1000);
+        const auto y = static_cast<float>(rng() % 1000);
+        buf << id << std::uint16_t(1) << x << y << 0.0f << std::uint8_t(100) << std::uint8_t(rng() % 4)
+            << std::uint64_t(0) << std::uint32_t(0xFFFF'FFFF) << std::uint16_t(rng() % 8);
+    }
+
+    return buf;
+}
+
+/// @brief Chat log made of the frequent words.
+auto make_chat_log() -> nb::SerializeBuffer<>
+{
+    std::mt19937 rng(42);
+    nb::SerializeBuffer<> buf(DATA_SIZE);
+
+    while (buf.available_space() >= 64)
+    {
+        std::string line = "[player" + std::to_string(rng() % 16) + "] ";
+        for (std::uint32_t word = 0, words = 2 + rng() % 6; word < words; ++word)
+            line.append(CHAT_WORDS[rng() % std::size(CHAT_WORDS)]).push_back(' ');
+        buf << line;
+    }
+
+    return buf;
+}
+
+/// @brief Random bytes, which are not compressible at all.
+auto make_random() -> nb::SerializeBuffer<>
+{
+    std::mt19937 rng(42);
+    nb::SerializeBuffer<> buf(DATA_SIZE);
+
+    while (!buf.full())
+        buf << static_cast<std::uint8_t>(rng());
+
+    return buf;
+}
+
+} // namespace
+
+template <typename MakeData>
+void bc_compress(benchmark::State& state, MakeData make_data)
+{
+    nb::SerializeBuffer<> src = make_data();
+    const std::size_t size = src.used_space();
+
+    nb::BlockCompressor compressor;
+    nb::SerializeBuffer<> dest(nb::BlockCompressor::max_compressed_size(size));
+
+    for (auto _ : state)
+    {
+        src.move_read_pos(-static_cast<std::ptrdiff_t>(src.read_pos()));
+        dest.clear();
+
+        compressor.try_compress(src, dest);
+        benchmark::DoNotOptimize(dest.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+    state.counters["ratio"] = static_cast<double>(size) / static_cast<double>(dest.used_space());
+}
+
+template <typename MakeData>
+void bc_decompress(benchmark::State& state, MakeData make_data)
+{
+    nb::SerializeBuffer<> src = make_data();
+    const std::size_t size = src.used_space();
+
+    nb::BlockCompressor compressor;
+    nb::SerializeBuffer<> compressed(nb::BlockCompressor::max_compressed_size(size));
+    compressor.try_compress(src, compressed);
+    const std::size_t compressed_size = compressed.used_space();
+
+    nb::SerializeBuffer<> dest(size);
+
+    for (auto _ : state)
+    {
+        compressed.move_read_pos(-static_cast<std::ptrdiff_t>(compressed.read_pos()));
+        dest.clear();
+
+        nb::BlockCompressor::try_decompress(compressed, dest);
+        benchmark::DoNotOptimize(dest.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+    state.counters["ratio"] = static_cast<double>(size) / static_cast<double>(compressed_size);
+}
+
+BENCHMARK_CAPTURE(bc_compress, snapshot, make_snapshot);
+BENCHMARK_CAPTURE(bc_compress, chat_log, make_chat_log);
+BENCHMARK_CAPTURE(bc_compress, random, make_random);
+
+BENCHMARK_CAPTURE(bc_decompress, snapshot, make_snapshot);
+BENCHMARK_CAPTURE(bc_decompress, chat_log, make_chat_log);
+BENCHMARK_CAPTURE(bc_decompress, random, make_random);
+
+BENCHMARK_MAIN();
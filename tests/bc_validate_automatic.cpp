@@ -0,0 +1,164 @@
+#include "NetBuff/BlockCompressor.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <source_location>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed " << #condition << " at phase #" << phase << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+namespace
+{
+
+constexpr std::size_t MAX_DATA_SIZE = 100000;
+
+constexpr int PHASES = 500;
+
+/// @brief Fill `data` with random runs, repeats of the previous bytes & random bytes.
+void fill_compressible(std::vector<std::byte>& data, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> kind_dist(0, 2);
+    std::uniform_int_distribution<std::size_t> len_dist(1, 300);
+    std::uniform_int_distribution<unsigned> byte_dist(0, 255);
+
+    std::size_t pos = 0;
+    while (pos < data.size())
+    {
+        const std::size_t len = std::min(len_dist(rng), data.size() - pos);
+        switch (kind_dist(rng))
+        {
+        case 0: {
+            const auto byte = static_cast<std::byte>(byte_dist(rng));
+            for (std::size_t idx = 0; idx < len; ++idx)
+                data[pos + idx] = byte;
+            break;
+        }
+        case 1:
+            if (pos > 0)
+            {
+                // possibly overlapping repeat
+                const std::size_t offset =
+                    std::uniform_int_distribution<std::size_t>(1, std::min<std::size_t>(pos, 70000))(rng);
+                for (std::size_t idx = 0; idx < len; ++idx)
+                    data[pos + idx] = data[pos + idx - offset];
+                break;
+            }
+            [[fallthrough]];
+        default:
+            for (std::size_t idx = 0; idx < len; ++idx)
+                data[pos + idx] = static_cast<std::byte>(byte_dist(rng));
+            break;
+        }
+        pos += len;
+    }
+}
+
+void validate(std::mt19937& rng)
+{
+    std::uniform_int_distribution<std::size_t> size_dist(0, MAX_DATA_SIZE);
+    std::uniform_int_distribution<unsigned> byte_dist(0, 255);
+
+    nb::BlockCompressor compressor;
+
+    for (int phase = 1; phase <= PHASES; ++phase)
+    {
+        // small sizes are the edge cases
+        const std::size_t size = (phase % 4 == 0) ? size_dist(rng) % 32 : size_dist(rng);
+
+        std::vector<std::byte> data(size);
+        if (phase % 8 == 1)
+        {
+            for (auto& byte : data)
+                byte = static_cast<std::byte>(byte_dist(rng));
+        }
+        else
+        {
+            fill_compressible(data, rng);
+        }
+
+        nb::SerializeBuffer<> src(size);
+        if (size > 0)
+            TEST_ASSERT(src.try_write(data.data(), size));
+
+        // compress
+        nb::SerializeBuffer<> compressed(nb::BlockCompressor::max_compressed_size(size));
+        TEST_ASSERT(compressor.try_compress(src, compressed));
+        TEST_ASSERT(src.empty());
+        TEST_ASSERT(compressed.used_space() <= nb::BlockCompressor::max_compressed_size(size));
+
+        // compress fails without enough space, without touching the buffers
+        if (compressed.used_space() > 0)
+        {
+            src.clear();
+            if (size > 0)
+                TEST_ASSERT(src.try_write(data.data(), size));
+            nb::SerializeBuffer<> too_small(compressed.used_space() - 1);
+            TEST_ASSERT(!compressor.try_compress(src, too_small));
+            TEST_ASSERT(size == src.used_space());
+            TEST_ASSERT(too_small.empty());
+        }
+
+        // decompress fails without enough space
+        if (size > 0)
+        {
+            nb::SerializeBuffer<> too_small(size - 1);
+            TEST_ASSERT(!nb::BlockCompressor::try_decompress(compressed, too_small));
+            TEST_ASSERT(too_small.empty());
+        }
+
+        // decompress
+        nb::SerializeBuffer<> decompressed(size);
+        TEST_ASSERT(nb::BlockCompressor::try_decompress(compressed, decompressed));
+        TEST_ASSERT(compressed.empty());
+        TEST_ASSERT(size == decompressed.used_space());
+        TEST_ASSERT(0 == size || 0 == std::memcmp(data.data(), decompressed.data(), size));
+
+        // malformed blocks must be rejected or decompressed, without overrun
+        if (compressed.write_pos() > 0)
+        {
+            compressed.data()[std::uniform_int_distribution<std::size_t>(0, compressed.write_pos() - 1)(rng)] ^=
+                static_cast<std::byte>(1u << (byte_dist(rng) % 8));
+            compressed.move_read_pos(-static_cast<std::ptrdiff_t>(compressed.write_pos()));
+            decompressed.clear();
+            nb::BlockCompressor::try_decompress(compressed, decompressed);
+
+            std::size_t decompressed_size;
+            const std::size_t truncated = compressed.write_pos() / 2;
+            nb::BlockCompressor::try_decompress(compressed.data(), truncated, decompressed.data(), size,
+                                                decompressed_size);
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    std::mt19937 rng(seed);
+
+    validate(rng);
+
+    std::cout << "All is well!" << std::endl;
+}
@@ -0,0 +1,195 @@
+#include "NetBuff/BitStream.hpp"
+#include "NetBuff/SerializeBuffer.hpp"
+#include "NetBuff/SerializeReader.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <source_location>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed " << #condition << " at phase #" << phase << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+namespace
+{
+
+constexpr std::size_t BUF_SIZE = 1024;
+constexpr int OPS_PER_PHASE = 100;
+
+constexpr int PHASES = 10000;
+
+constexpr float QUANTIZE_MIN = -100.0f;
+constexpr float QUANTIZE_MAX = 100.0f;
+
+enum class OpKind
+{
+    BITS,
+    BOOL,
+    QUANTIZED,
+    ALIGNED_U32, // `align()`, and then a byte-aligned field
+
+    COUNT
+};
+
+struct Op
+{
+    OpKind kind;
+    unsigned bits;
+    std::uint64_t value;
+    float value_f;
+};
+
+void validate(std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> kind_dist(0, static_cast<int>(OpKind::COUNT) - 1);
+    std::uniform_int_distribution<unsigned> bits_dist(0, 64);
+    std::uniform_int_distribution<unsigned> quantize_bits_dist(1, 24);
+    std::uniform_int_distribution<std::uint64_t> value_dist;
+    std::uniform_real_distribution<float> float_dist(QUANTIZE_MIN * 1.1f, QUANTIZE_MAX * 1.1f);
+
+    std::vector<Op> ops;
+
+    for (int phase = 1; phase <= PHASES; ++phase)
+    {
+        nb::SerializeBuffer<> buf(BUF_SIZE);
+
+        // write
+        ops.clear();
+        std::size_t written_bits = 0;
+        {
+            nb::BitWriter writer(buf);
+            for (int idx = 0; idx < OPS_PER_PHASE; ++idx)
+            {
+                Op op{static_cast<OpKind>(kind_dist(rng)), 0, value_dist(rng), 0};
+                switch (op.kind)
+                {
+                case OpKind::BITS:
+                    op.bits = bits_dist(rng);
+                    TEST_ASSERT(writer.try_write_bits(op.value, op.bits));
+                    written_bits += op.bits;
+                    break;
+                case OpKind::BOOL:
+                    op.value &= 1;
+                    TEST_ASSERT(writer.try_write_bool(op.value));
+                    written_bits += 1;
+                    break;
+                case OpKind::QUANTIZED:
+                    op.bits = quantize_bits_dist(rng);
+                    op.value_f = float_dist(rng);
+                    TEST_ASSERT(writer.try_write_quantized(op.value_f, QUANTIZE_MIN, QUANTIZE_MAX, op.bits));
+                    written_bits += op.bits;
+                    break;
+                case OpKind::ALIGNED_U32:
+                    writer.align();
+                    TEST_ASSERT(0 == writer.pending_bits());
+                    TEST_ASSERT(buf << static_cast<std::uint32_t>(op.value));
+                    written_bits = buf.used_space() * 8;
+                    break;
+                default:
+                    TEST_ASSERT(false);
+                }
+                ops.push_back(op);
+            }
+            TEST_ASSERT(writer);
+        }
+        TEST_ASSERT((written_bits + 7) / 8 == buf.used_space());
+
+        // read
+        {
+            nb::SerializeReader reader({buf.data(), buf.used_space()});
+            nb::BitReader bit_reader(reader);
+            for (const Op& op : ops)
+            {
+                std::uint64_t value;
+                bool value_b;
+                float value_f;
+                std::uint32_t value_32;
+
+                switch (op.kind)
+                {
+                case OpKind::BITS:
+                    TEST_ASSERT(bit_reader.try_read_bits(value, op.bits));
+                    TEST_ASSERT((op.bits == 64 ? op.value : op.value & ((std::uint64_t(1) << op.bits) - 1)) == value);
+                    break;
+                case OpKind::BOOL:
+                    TEST_ASSERT(bit_reader.try_read_bool(value_b));
+                    TEST_ASSERT((op.value != 0) == value_b);
+                    break;
+                case OpKind::QUANTIZED: {
+                    TEST_ASSERT(bit_reader.try_read_quantized(value_f, QUANTIZE_MIN, QUANTIZE_MAX, op.bits));
+                    const float expected = std::clamp(op.value_f, QUANTIZE_MIN, QUANTIZE_MAX);
+                    const float step = (QUANTIZE_MAX - QUANTIZE_MIN) / static_cast<float>((1u << op.bits) - 1);
+                    TEST_ASSERT(std::abs(expected - value_f) <= step * 0.5f + 1e-4f);
+                    break;
+                }
+                case OpKind::ALIGNED_U32:
+                    bit_reader.align();
+                    TEST_ASSERT(reader >> value_32);
+                    TEST_ASSERT(static_cast<std::uint32_t>(op.value) == value_32);
+                    break;
+                default:
+                    TEST_ASSERT(false);
+                }
+            }
+            TEST_ASSERT(bit_reader.available_bits() < 8);
+            TEST_ASSERT(bit_reader);
+
+            std::uint64_t value;
+            TEST_ASSERT(!bit_reader.try_read_bits(value, 8));
+            TEST_ASSERT(bit_reader.fail());
+        }
+
+        // overflow
+        {
+            nb::SerializeBuffer<> small_buf(3);
+            nb::BitWriter writer(small_buf);
+            TEST_ASSERT(writer.try_write_bits(0x1F'FFFF, 21));
+            TEST_ASSERT(3 == writer.available_bits());
+            TEST_ASSERT(!writer.try_write_bits(0, 4));
+            TEST_ASSERT(writer.fail());
+            TEST_ASSERT(writer.try_write_bits(0b101, 3));
+            writer.align();
+            TEST_ASSERT(3 == small_buf.used_space());
+
+            nb::BitReader reader(small_buf);
+            std::uint32_t value;
+            TEST_ASSERT(reader.try_read_bits(value, 21));
+            TEST_ASSERT(0x1F'FFFF == value);
+            std::uint8_t value_8;
+            TEST_ASSERT(reader.try_read_bits(value_8, 3));
+            TEST_ASSERT(0b101 == value_8);
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    std::mt19937 rng(seed);
+
+    validate(rng);
+
+    std::cout << "All is well!" << std::endl;
+}
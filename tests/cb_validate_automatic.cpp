@@ -0,0 +1,240 @@
+#include "NetBuff/ChainedBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <source_location>
+#include <span>
+#include <string>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed " << #condition << " at phase #" << phase << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+namespace
+{
+
+constexpr std::size_t SEGMENT_SIZE = 16;
+
+constexpr int PHASES = 10000;
+constexpr int MAX_BYTES_PER_PHASE = 4096;
+constexpr std::size_t MAX_CHUNK_SIZE = 64;
+
+using Buffer = nb::ChainedBuffer<SEGMENT_SIZE>;
+
+bool allocation_fails = false;
+
+/// @brief Throws `std::bad_alloc` while `allocation_fails` is set.
+template <typename T>
+struct ThrowingAllocator
+{
+    using value_type = T;
+
+    ThrowingAllocator() = default;
+
+    template <typename U>
+    ThrowingAllocator(const ThrowingAllocator<U>&) noexcept
+    {
+    }
+
+    auto allocate(std::size_t n) -> T*
+    {
+        if (allocation_fails)
+            throw std::bad_alloc();
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    bool operator==(const ThrowingAllocator&) const = default;
+};
+
+} // namespace
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    std::mt19937 rng(seed);
+
+    std::uniform_int_distribution<std::uint64_t> u64_dist;
+    std::uniform_int_distribution yes_or_no(0, 1);
+
+    std::vector<std::byte> buffer_input(MAX_BYTES_PER_PHASE);
+    std::vector<std::byte> buffer_output(MAX_BYTES_PER_PHASE);
+    std::size_t pos_input = 0;
+    std::size_t pos_output = 0;
+
+    Buffer::SegmentPool pool;
+
+    {
+        Buffer buf(pool);
+
+        auto buf_read = [&](int phase) {
+            std::uniform_int_distribution<std::size_t> dist(
+                1, std::min({buf.used_space(), buffer_output.size() - pos_output, MAX_CHUNK_SIZE}));
+            const std::size_t size = dist(rng);
+
+            // gathered segments should be same as the front bytes
+            std::array<std::span<const std::byte>, MAX_CHUNK_SIZE / SEGMENT_SIZE + 2> segments;
+            const std::size_t count = buf.gather(segments);
+            TEST_ASSERT(count > 0);
+            TEST_ASSERT(std::equal(segments[0].begin(), segments[0].end(), buffer_input.begin() + pos_output));
+
+            const bool read_result = buf.try_read(buffer_output.data() + pos_output, size);
+            TEST_ASSERT(read_result);
+
+            pos_output += size;
+        };
+
+        auto buf_write = [&](int phase) {
+            std::uniform_int_distribution<std::size_t> dist(1,
+                                                            std::min(buffer_input.size() - pos_input, MAX_CHUNK_SIZE));
+            const std::size_t size = dist(rng);
+
+            const bool write_result = buf.try_write(buffer_input.data() + pos_input, size);
+            TEST_ASSERT(write_result);
+
+            pos_input += size;
+        };
+
+        for (int phase = 0; phase < PHASES; ++phase)
+        {
+            pos_input = 0;
+            pos_output = 0;
+
+            // fill `buffer_input` with random bytes
+            static_assert(MAX_BYTES_PER_PHASE % 8 == 0);
+            for (int i = 0; i < MAX_BYTES_PER_PHASE / 8; ++i)
+            {
+                auto& val = reinterpret_cast<std::uint64_t*>(buffer_input.data())[i];
+                val = u64_dist(rng);
+            }
+
+            // fill `buffer_output` w/ going through `buf`
+            while (pos_output < buffer_output.size())
+            {
+                if (pos_input == buffer_input.size())
+                    buf_read(phase);
+                else if (buf.empty())
+                    buf_write(phase);
+                else
+                {
+                    if (yes_or_no(rng))
+                        buf_read(phase);
+                    else
+                        buf_write(phase);
+                }
+            }
+
+            // validate: [input == output]
+            TEST_ASSERT(buffer_input == buffer_output);
+            TEST_ASSERT(buf.empty());
+            TEST_ASSERT(0 == buf.segment_count());
+            TEST_ASSERT(0 == pool.used_slots());
+        }
+
+        // typed values straddling segments
+        constexpr int phase = PHASES;
+
+        const std::uint8_t u8 = 0x12;
+        const std::uint64_t u64 = 0x0123'4567'89ab'cdef;
+        const double d = 3.14;
+        const std::u16string u16str = u"The quick brown fox jumps over the lazy dog!";
+        const char* c_str = "Hello, world!";
+
+        std::uint8_t u8_out;
+        std::uint64_t u64_out;
+        double d_out;
+        std::u16string u16str_out;
+        char c_str_out[32];
+
+        TEST_ASSERT(buf << u8 << u64 << d << u16str << c_str);
+        TEST_ASSERT(buf.segment_count() > 1);
+        TEST_ASSERT(buf.try_peek(u8_out));
+        TEST_ASSERT(u8 == u8_out);
+        TEST_ASSERT(buf >> u8_out >> u64_out >> d_out >> u16str_out >> c_str_out);
+        TEST_ASSERT(u8 == u8_out);
+        TEST_ASSERT(u64 == u64_out);
+        TEST_ASSERT(d == d_out);
+        TEST_ASSERT(u16str == u16str_out);
+        TEST_ASSERT(std::string(c_str) == c_str_out);
+        TEST_ASSERT(buf.empty());
+        TEST_ASSERT(!(buf >> u8_out));
+        TEST_ASSERT(buf.fail());
+
+        // move keeps the segments
+        buf.clear();
+        TEST_ASSERT(buf << u64);
+        Buffer buf2(std::move(buf));
+        TEST_ASSERT(buf.empty());
+        TEST_ASSERT(1 == buf2.segment_count());
+        TEST_ASSERT(buf2 >> u64_out);
+        TEST_ASSERT(u64 == u64_out);
+    }
+
+    // segments which couldn't be taken don't leave anything behind
+    {
+        constexpr int phase = PHASES + 1;
+
+        using ThrowingBuffer = nb::ChainedBuffer<SEGMENT_SIZE, ThrowingAllocator<std::byte>>;
+        ThrowingBuffer::SegmentPool throwing_pool(2);
+        ThrowingBuffer buf(throwing_pool);
+
+        std::array<std::byte, SEGMENT_SIZE * 4> data;
+        for (std::size_t idx = 0; idx < data.size(); ++idx)
+            data[idx] = static_cast<std::byte>(idx);
+
+        TEST_ASSERT(buf.try_write(data.data(), SEGMENT_SIZE + 4));
+
+        allocation_fails = true;
+        bool thrown = false;
+        try
+        {
+            buf.try_write(data.data(), SEGMENT_SIZE * 2);
+        }
+        catch (const std::bad_alloc&)
+        {
+            thrown = true;
+        }
+        allocation_fails = false;
+
+        TEST_ASSERT(thrown);
+        TEST_ASSERT(SEGMENT_SIZE + 4 == buf.used_space());
+        TEST_ASSERT(2 == buf.segment_count());
+        TEST_ASSERT(2 == throwing_pool.used_slots());
+
+        // the next write continues right after the existing data
+        TEST_ASSERT(buf.try_write(data.data() + SEGMENT_SIZE + 4, SEGMENT_SIZE * 2));
+        std::array<std::byte, SEGMENT_SIZE * 3 + 4> out;
+        TEST_ASSERT(buf.try_read(out.data(), out.size()));
+        TEST_ASSERT(std::equal(out.begin(), out.end(), data.begin()));
+        TEST_ASSERT(buf.empty());
+    }
+
+    std::cout << "All is well!" << std::endl;
+}
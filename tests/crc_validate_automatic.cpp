@@ -0,0 +1,128 @@
+#include "NetBuff/Crc32c.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <source_location>
+#include <span>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed " << #condition << " at phase #" << phase << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+namespace
+{
+
+constexpr std::size_t MAX_DATA_SIZE = 1000;
+constexpr std::size_t RING_SIZE = 1200;
+
+constexpr int PHASES = 10000;
+
+// bitwise reference implementation
+auto reference_crc32c(std::span<const std::byte> data) -> std::uint32_t
+{
+    std::uint32_t crc = 0xFFFF'FFFF;
+    for (const std::byte byte : data)
+    {
+        crc ^= static_cast<std::uint8_t>(byte);
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 1) ? (crc >> 1) ^ nb::Crc32c::POLYNOMIAL : (crc >> 1);
+    }
+    return ~crc;
+}
+
+void validate_known_values()
+{
+    constexpr int phase = 0;
+
+    const char check[] = "123456789";
+    TEST_ASSERT(0xE306'9283 == nb::Crc32c::compute(check, sizeof(check) - 1));
+    TEST_ASSERT(0 == nb::Crc32c::compute(nullptr, 0));
+
+    const std::vector<std::byte> zeros(32, std::byte(0));
+    TEST_ASSERT(0x8A91'36AA == nb::Crc32c::compute(zeros));
+}
+
+void validate(std::mt19937& rng)
+{
+    std::uniform_int_distribution<std::size_t> size_dist(0, MAX_DATA_SIZE);
+    std::uniform_int_distribution<unsigned> byte_dist(0, 255);
+
+    std::vector<std::byte> data(MAX_DATA_SIZE);
+    nb::RingByteBuffer<> ring(RING_SIZE);
+
+    for (int phase = 1; phase <= PHASES; ++phase)
+    {
+        const std::size_t size = size_dist(rng);
+        for (std::size_t idx = 0; idx < size; ++idx)
+            data[idx] = static_cast<std::byte>(byte_dist(rng));
+
+        const auto span = std::span<const std::byte>(data.data(), size);
+        const std::uint32_t expected = reference_crc32c(span);
+        TEST_ASSERT(expected == nb::Crc32c::compute(span));
+
+        // incremental update with random split
+        const std::size_t split = std::uniform_int_distribution<std::size_t>(0, size)(rng);
+        nb::Crc32c crc;
+        crc.update(span.first(split));
+        crc.update(span.subspan(split));
+        TEST_ASSERT(expected == crc.value());
+
+        // writer over `SerializeBuffer`
+        nb::SerializeBuffer<> buf(MAX_DATA_SIZE + nb::Crc32c::CHECKSUM_SIZE);
+        nb::Crc32cWriter writer(buf);
+        TEST_ASSERT(writer.try_write(span.data(), split));
+        TEST_ASSERT(writer.try_write(span.data() + split, size - split));
+        TEST_ASSERT(expected == writer.checksum());
+        TEST_ASSERT(writer.try_write_checksum());
+        TEST_ASSERT(!writer.try_write(std::uint8_t(0)) == (size == MAX_DATA_SIZE));
+        writer.clear();
+
+        TEST_ASSERT(nb::crc32c_verify(buf, size));
+        TEST_ASSERT(nb::Crc32c::verify({buf.data(), size + nb::Crc32c::CHECKSUM_SIZE}));
+        if (size > 0)
+        {
+            buf.data()[split == size ? 0 : split] ^= std::byte(1);
+            TEST_ASSERT(!nb::crc32c_verify(buf, size));
+        }
+
+        // writer over `RingByteBuffer`, which wraps around randomly
+        nb::Crc32cWriter ring_writer(ring);
+        TEST_ASSERT(ring_writer.try_write(span.data(), size));
+        TEST_ASSERT(ring_writer.try_write_checksum());
+        TEST_ASSERT(nb::crc32c_verify(ring, size));
+        TEST_ASSERT(!nb::crc32c_verify(ring, size + 1));
+        ring.move_read_pos(size + nb::Crc32c::CHECKSUM_SIZE);
+        TEST_ASSERT(ring.empty());
+    }
+}
+
+} // namespace
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    std::mt19937 rng(seed);
+
+    validate_known_values();
+    validate(rng);
+
+    std::cout << "All is well!" << std::endl;
+}
@@ -0,0 +1,242 @@
+#include "NetBuff/DeltaCodec.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <source_location>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed " << #condition << " at phase #" << phase << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+namespace
+{
+
+constexpr std::size_t MAX_SNAPSHOT_SIZE = 300;
+constexpr std::size_t MAX_CHANGES = 8;
+
+constexpr int PHASES = 100000;
+
+void validate(std::mt19937& rng)
+{
+    std::uniform_int_distribution<std::size_t> size_dist(0, MAX_SNAPSHOT_SIZE);
+    std::uniform_int_distribution<std::size_t> change_count_dist(0, MAX_CHANGES);
+    std::uniform_int_distribution<unsigned> byte_dist(0, 255);
+
+    std::vector<std::byte> baseline(size_dist(rng));
+    for (auto& byte : baseline)
+        byte = static_cast<std::byte>(byte_dist(rng));
+
+    nb::SerializeBuffer<> snapshot(MAX_SNAPSHOT_SIZE);
+    if (!baseline.empty())
+        snapshot.try_write(baseline.data(), baseline.size());
+
+    nb::SerializeBuffer<> delta(nb::DeltaCodec::max_encoded_size(MAX_SNAPSHOT_SIZE));
+
+    for (int phase = 1; phase <= PHASES; ++phase)
+    {
+        // size changes sometimes
+        std::vector<std::byte> current = baseline;
+        if (phase % 16 == 0)
+        {
+            current.resize(size_dist(rng));
+            for (std::size_t idx = baseline.size(); idx < current.size(); ++idx)
+                current[idx] = static_cast<std::byte>(byte_dist(rng));
+        }
+
+        // change a few bytes
+        const std::size_t changes = current.empty() ? 0 : change_count_dist(rng);
+        for (std::size_t change = 0; change < changes; ++change)
+        {
+            const std::size_t idx = std::uniform_int_distribution<std::size_t>(0, current.size() - 1)(rng);
+            current[idx] ^= static_cast<std::byte>(1 + byte_dist(rng) % 255);
+        }
+
+        // encode
+        delta.clear();
+        TEST_ASSERT(nb::DeltaCodec::try_encode(baseline, current, delta));
+        TEST_ASSERT(delta.used_space() <= nb::DeltaCodec::max_encoded_size(current.size()));
+        if (current.size() == baseline.size())
+        {
+            const std::size_t groups = (current.size() + 7) / 8;
+            TEST_ASSERT(delta.used_space() <= 2 + (groups + 7) / 8 + 2 * changes);
+        }
+
+        // encode from `SerializeBuffer`s
+        if (phase % 8 == 0)
+        {
+            nb::SerializeBuffer<> baseline_buf(baseline.size()), current_buf(current.size());
+            if (!baseline.empty())
+                TEST_ASSERT(baseline_buf.try_write(baseline.data(), baseline.size()));
+            if (!current.empty())
+                TEST_ASSERT(current_buf.try_write(current.data(), current.size()));
+
+            nb::SerializeBuffer<> delta_buf(delta.used_space());
+            TEST_ASSERT(nb::DeltaCodec::try_encode(baseline_buf, current_buf, delta_buf));
+            TEST_ASSERT(delta.used_space() == delta_buf.used_space());
+            TEST_ASSERT(0 == std::memcmp(delta.data(), delta_buf.data(), delta.used_space()));
+        }
+
+        // encode fails without enough space
+        if (delta.used_space() > 0)
+        {
+            nb::SerializeBuffer<> too_small(delta.used_space() - 1);
+            TEST_ASSERT(!nb::DeltaCodec::try_encode(baseline, current, too_small));
+            TEST_ASSERT(too_small.empty());
+        }
+
+        // corrupted delta must be rejected or applied, without overrun
+        if (phase % 8 == 0)
+        {
+            nb::SerializeBuffer<> corrupted(delta.used_space());
+            TEST_ASSERT(corrupted.try_write(delta.data(), delta.used_space()));
+            corrupted.data()[std::uniform_int_distribution<std::size_t>(0, delta.used_space() - 1)(rng)] ^=
+                static_cast<std::byte>(1u << (byte_dist(rng) % 8));
+
+            nb::SerializeBuffer<> corrupted_snapshot(MAX_SNAPSHOT_SIZE * 2);
+            if (!baseline.empty())
+                corrupted_snapshot.try_write(baseline.data(), baseline.size());
+            nb::DeltaCodec::try_apply(corrupted, corrupted_snapshot);
+        }
+
+        // apply in place
+        TEST_ASSERT(nb::DeltaCodec::try_apply(delta, snapshot));
+        TEST_ASSERT(delta.empty());
+        TEST_ASSERT(current.size() == snapshot.used_space());
+        TEST_ASSERT(current.empty() || 0 == std::memcmp(current.data(), snapshot.data(), current.size()));
+
+        baseline = std::move(current);
+    }
+
+    // truncated delta is rejected, without touching the buffers
+    {
+        constexpr int phase = PHASES + 1;
+
+        std::vector<std::byte> current = baseline;
+        for (auto& byte : current)
+            byte = ~byte;
+
+        delta.clear();
+        TEST_ASSERT(nb::DeltaCodec::try_encode(baseline, current, delta));
+        delta.move_write_pos(-1);
+        TEST_ASSERT(!nb::DeltaCodec::try_apply(delta, snapshot));
+        TEST_ASSERT(0 == delta.read_pos());
+        TEST_ASSERT(baseline.size() == snapshot.used_space());
+        TEST_ASSERT(!delta.fail() && !snapshot.fail());
+    }
+}
+
+/// @brief Every failure path leaves the buffers as they were, including their fail bits.
+void validate_failures()
+{
+    std::vector<std::byte> baseline(20, std::byte(0x11));
+    std::vector<std::byte> current(20, std::byte(0x22));
+
+    // encode: no space for the size field & the group mask
+    {
+        constexpr int phase = PHASES + 2;
+
+        nb::SerializeBuffer<> dest(1);
+        TEST_ASSERT(!nb::DeltaCodec::try_encode(baseline, current, dest));
+        TEST_ASSERT(dest.empty() && !dest.fail());
+    }
+
+    // encode: no space for the changed groups
+    {
+        constexpr int phase = PHASES + 3;
+
+        nb::SerializeBuffer<> dest(10);
+        TEST_ASSERT(!nb::DeltaCodec::try_encode(baseline, current, dest));
+        TEST_ASSERT(dest.empty() && !dest.fail());
+    }
+
+    const auto expect_rejected = [&](int phase, const std::vector<std::byte>& bytes) {
+        nb::SerializeBuffer<> malformed(bytes.size());
+        if (!bytes.empty())
+            TEST_ASSERT(malformed.try_write(bytes.data(), bytes.size()));
+
+        nb::SerializeBuffer<> snapshot(baseline.size());
+        TEST_ASSERT(snapshot.try_write(baseline.data(), baseline.size()));
+
+        TEST_ASSERT(!nb::DeltaCodec::try_apply(malformed, snapshot));
+        TEST_ASSERT(0 == malformed.read_pos() && bytes.size() == malformed.used_space() && !malformed.fail());
+        TEST_ASSERT(baseline.size() == snapshot.used_space() && !snapshot.fail());
+        TEST_ASSERT(0 == std::memcmp(baseline.data(), snapshot.data(), baseline.size()));
+    };
+
+    // size field (1 byte), group mask (1 byte), 2 full groups (9 bytes each), last group of 4 bytes (5 bytes)
+    std::vector<std::byte> valid;
+    {
+        constexpr int phase = PHASES + 4;
+
+        nb::SerializeBuffer<> delta(nb::DeltaCodec::max_encoded_size(current.size()));
+        TEST_ASSERT(nb::DeltaCodec::try_encode(baseline, current, delta));
+        valid.assign(delta.data(), delta.data() + delta.used_space());
+        TEST_ASSERT(25 == valid.size());
+    }
+
+    // apply: empty, incomplete & overflowed size field
+    expect_rejected(PHASES + 5, {});
+    expect_rejected(PHASES + 6, {std::byte(0x80)});
+    expect_rejected(PHASES + 7, std::vector<std::byte>(5, std::byte(0xFF)));
+
+    // apply: no space for the grown snapshot
+    {
+        std::vector<std::byte> grown = valid;
+        grown[0] = std::byte(21);
+        expect_rejected(PHASES + 8, grown);
+    }
+
+    // apply: truncated group mask
+    expect_rejected(PHASES + 9, {valid[0]});
+
+    // apply: bits beyond the last group
+    {
+        std::vector<std::byte> extra_group = valid;
+        extra_group[1] |= std::byte(1u << 3);
+        expect_rejected(PHASES + 10, extra_group);
+    }
+
+    // apply: truncated byte mask or changed bytes
+    expect_rejected(PHASES + 11, std::vector<std::byte>(valid.begin(), valid.begin() + 2));
+    expect_rejected(PHASES + 12, std::vector<std::byte>(valid.begin(), valid.end() - 1));
+
+    // apply: bytes beyond the last byte
+    {
+        std::vector<std::byte> extra_byte = valid;
+        extra_byte[valid.size() - 5] |= std::byte(1u << 4);
+        expect_rejected(PHASES + 13, extra_byte);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    std::mt19937 rng(seed);
+
+    validate(rng);
+    validate_failures();
+
+    std::cout << "All is well!" << std::endl;
+}
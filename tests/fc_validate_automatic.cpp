@@ -0,0 +1,131 @@
+#include "NetBuff/FrameCodec.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <source_location>
+#include <span>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed " << #condition << " at phase #" << phase << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+namespace
+{
+
+constexpr std::size_t MAX_PAYLOAD_SIZE = 300;
+constexpr std::size_t RING_SIZE = 1024;
+constexpr std::size_t MAX_CHUNK_SIZE = 200;
+
+constexpr int PHASES = 1000;
+constexpr int FRAMES_PER_PHASE = 64;
+
+template <nb::FrameLengthType LengthType>
+void validate(std::mt19937& rng)
+{
+    std::uniform_int_distribution<std::size_t> payload_size_dist(0, MAX_PAYLOAD_SIZE);
+    std::uniform_int_distribution<unsigned> byte_dist(0, 255);
+
+    nb::FrameCodec<LengthType> codec(MAX_PAYLOAD_SIZE);
+
+    nb::RingByteBuffer<> ring(RING_SIZE);
+    std::vector<std::vector<std::byte>> frames_input;
+    std::vector<std::vector<std::byte>> frames_output;
+
+    // encoded stream of `frames_input`, to feed `ring` in random chunks
+    constexpr std::size_t MAX_FRAME_SIZE = MAX_PAYLOAD_SIZE + nb::FrameCodec<LengthType>::MAX_HEADER_SIZE;
+    nb::RingByteBuffer<> stream_ring(FRAMES_PER_PHASE * MAX_FRAME_SIZE);
+    std::vector<std::byte> stream;
+
+    for (int phase = 0; phase < PHASES; ++phase)
+    {
+        frames_input.clear();
+        frames_output.clear();
+
+        // encode random frames
+        for (int f = 0; f < FRAMES_PER_PHASE; ++f)
+        {
+            auto& frame = frames_input.emplace_back(payload_size_dist(rng));
+            for (auto& b : frame)
+                b = static_cast<std::byte>(byte_dist(rng));
+
+            TEST_ASSERT(codec.try_write_frame(stream_ring, frame));
+        }
+        stream.resize(stream_ring.used_space());
+        TEST_ASSERT(stream_ring.try_read(stream.data(), stream.size()));
+
+        // feed the stream to `ring` in random chunks, and decode
+        for (std::size_t pos = 0; pos < stream.size();)
+        {
+            const auto chunk_size = std::uniform_int_distribution<std::size_t>(
+                1, std::min({MAX_CHUNK_SIZE, stream.size() - pos, ring.available_space()}))(rng);
+            TEST_ASSERT(ring.try_write(stream.data() + pos, chunk_size));
+            pos += chunk_size;
+
+            codec.decode(ring, [&](std::span<const std::byte> payload) {
+                frames_output.emplace_back(payload.begin(), payload.end());
+            });
+            TEST_ASSERT(!codec.fail());
+            TEST_ASSERT(codec.bytes_needed() > 0);
+        }
+
+        // validate: [input == output]
+        TEST_ASSERT(ring.empty());
+        TEST_ASSERT(frames_input == frames_output);
+    }
+
+    // too large frame is malformed
+    constexpr int phase = PHASES;
+    std::array<std::byte, nb::FrameCodec<LengthType>::MAX_HEADER_SIZE> header;
+    const std::size_t header_size = codec.encode_header(MAX_PAYLOAD_SIZE + 1, header.data());
+    TEST_ASSERT(ring.try_write(header.data(), header_size));
+    TEST_ASSERT(0 == codec.decode(ring, [](std::span<const std::byte>) {}));
+    TEST_ASSERT(codec.fail());
+    codec.clear();
+    TEST_ASSERT(!codec.fail());
+
+    // varint header with more than 32 bits is malformed, even if it'd wrap around to a small size
+    if constexpr (LengthType == nb::FrameLengthType::VARINT)
+    {
+        ring.clear();
+        const std::byte overflowed[] = {std::byte(0x85), std::byte(0x80), std::byte(0x80), std::byte(0x80),
+                                        std::byte(0x10)};
+        TEST_ASSERT(ring.try_write(overflowed, sizeof(overflowed)));
+        TEST_ASSERT(0 == codec.decode(ring, [](std::span<const std::byte>) {}));
+        TEST_ASSERT(codec.fail());
+        codec.clear();
+    }
+}
+
+} // namespace
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    std::mt19937 rng(seed);
+
+    validate<nb::FrameLengthType::U16>(rng);
+    validate<nb::FrameLengthType::U32>(rng);
+    validate<nb::FrameLengthType::VARINT>(rng);
+
+    std::cout << "All is well!" << std::endl;
+}
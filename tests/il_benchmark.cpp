@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include "NetBuff/IntrusiveList.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t ENTITY_COUNT = 100000;
+
+struct Entity : public nb::IntrusiveListNode
+{
+    float pos[3];
+    float vel[3];
+    std::uint32_t id;
+    std::uint32_t flags;
+    std::byte state[80];
+};
+
+using EntityList = nb::IntrusiveList<Entity>;
+
+/// @brief Entities linked in a random order, like after churning in a pool.
+struct ChurnedEntities
+{
+    std::unique_ptr<Entity[]> storage = std::make_unique<Entity[]>(ENTITY_COUNT);
+    EntityList list;
+
+    ChurnedEntities()
+    {
+        std::vector<std::size_t> order(ENTITY_COUNT);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+        for (std::size_t idx : order)
+        {
+            Entity& entity = storage[idx];
+            entity.pos[0] = entity.pos[1] = entity.pos[2] = 0.0f;
+            entity.vel[0] = entity.vel[1] = entity.vel[2] = static_cast<float>(idx % 7);
+            entity.id = static_cast<std::uint32_t>(idx);
+            entity.flags = 0;
+            list.push_back(entity);
+        }
+    }
+};
+
+void update(Entity& entity)
+{
+    for (int axis = 0; axis < 3; ++axis)
+        entity.pos[axis] += entity.vel[axis] * 0.016f;
+}
+
+} // namespace
+
+void il_range_for(benchmark::State& state)
+{
+    ChurnedEntities entities;
+
+    for (auto _ : state)
+    {
+        for (Entity& entity : entities.list)
+            update(entity);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ENTITY_COUNT));
+}
+
+template <std::size_t Distance>
+void il_for_each_prefetch(benchmark::State& state)
+{
+    ChurnedEntities entities;
+
+    for (auto _ : state)
+    {
+        entities.list.for_each_prefetch<Distance>(update);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ENTITY_COUNT));
+}
+
+void il_range_for_sorted_by_address(benchmark::State& state)
+{
+    ChurnedEntities entities;
+    entities.list.sort_by_address();
+
+    for (auto _ : state)
+    {
+        for (Entity& entity : entities.list)
+            update(entity);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ENTITY_COUNT));
+}
+
+void il_sort_by_address(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ChurnedEntities entities;
+        state.ResumeTiming();
+
+        entities.list.sort_by_address();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * ENTITY_COUNT));
+}
+
+BENCHMARK(il_range_for)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(il_for_each_prefetch, 2)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(il_for_each_prefetch, 4)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(il_for_each_prefetch, 8)->Unit(benchmark::kMicrosecond);
+BENCHMARK(il_range_for_sorted_by_address)->Unit(benchmark::kMicrosecond);
+BENCHMARK(il_sort_by_address)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -6,6 +6,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <source_location>
+#include <type_traits>
 #include <utility>
 
 #define TEST_ASSERT(condition) \
@@ -34,7 +35,57 @@ struct MyInt : public nb::IntrusiveListNode
     }
 };
 
-bool list_equals(const nb::IntrusiveList<MyInt>& intru_list, std::initializer_list<int> init_list)
+struct ZoneTag;
+struct TimerTag;
+
+// unlinks itself on destruction
+struct Entity : public nb::AutoUnlinkIntrusiveListNode<>, public nb::AutoUnlinkIntrusiveListNode<ZoneTag>
+{
+    int num;
+
+    Entity(int num_) : num(num_)
+    {
+    }
+};
+
+// standard-layout, to be linked via its member
+struct TimedEntity
+{
+    int num;
+    nb::AutoUnlinkIntrusiveListNode<TimerTag> timer_node;
+
+    TimedEntity(int num_) : num(num_)
+    {
+    }
+};
+
+struct DirtyTag;
+
+// in 3 lists at once
+struct Session : public nb::IntrusiveListNode,
+                 public nb::TaggedIntrusiveListNode<ZoneTag>,
+                 public nb::TaggedIntrusiveListNode<DirtyTag>
+{
+    int num;
+
+    Session(int num_) : num(num_)
+    {
+    }
+};
+
+// standard-layout, to be linked via its member
+struct Timer
+{
+    int num;
+    nb::IntrusiveListNode timer_node;
+
+    Timer(int num_) : num(num_)
+    {
+    }
+};
+
+template <typename List>
+bool list_equals(const List& intru_list, std::initializer_list<int> init_list)
 {
     if (intru_list.size() != init_list.size())
         return false;
@@ -87,10 +138,11 @@ int main()
     list.pop_front();
     TEST_ASSERT(list_equals(list, {9, 1, 2, 3, 4}));
     TEST_ASSERT(list.size() == 5);
-    list.remove(arr[2]);
+    TEST_ASSERT(1 == list.remove(arr[2]));
+    TEST_ASSERT(0 == list.remove(arr[2]));
     TEST_ASSERT(list_equals(list, {9, 1, 3, 4}));
     TEST_ASSERT(list.size() == 4);
-    list.remove_if([](const MyInt& elem) { return elem == MyInt(3); });
+    TEST_ASSERT(1 == list.remove_if([](const MyInt& elem) { return elem == MyInt(3); }));
     TEST_ASSERT(list_equals(list, {9, 1, 4}));
     TEST_ASSERT(list.size() == 3);
 
@@ -115,5 +167,272 @@ int main()
     list.clear();
     TEST_ASSERT(list.empty());
 
+    // splice
+    list.insert(list.begin(), arr.begin(), arr.begin() + 5);
+    list2.insert(list2.begin(), arr.begin() + 5, arr.end());
+    list.splice(++list.begin(), list2, ++list2.begin());
+    TEST_ASSERT(list_equals(list, {0, 6, 1, 2, 3, 4}));
+    TEST_ASSERT(list_equals(list2, {5, 7, 8, 9}));
+    list.splice(list.end(), list2, list2.begin(), --list2.end());
+    TEST_ASSERT(list_equals(list, {0, 6, 1, 2, 3, 4, 5, 7, 8}));
+    TEST_ASSERT(list_equals(list2, {9}));
+    list.splice(list.begin(), list2);
+    TEST_ASSERT(list_equals(list, {9, 0, 6, 1, 2, 3, 4, 5, 7, 8}));
+    TEST_ASSERT(list2.empty());
+    list.splice(list.begin(), list, --list.end()); // within a list
+    TEST_ASSERT(list_equals(list, {8, 9, 0, 6, 1, 2, 3, 4, 5, 7}));
+    list.splice(list.begin(), list, list.begin()); // no-op
+    list.splice(++list.begin(), list, list.begin());
+    TEST_ASSERT(list_equals(list, {8, 9, 0, 6, 1, 2, 3, 4, 5, 7}));
+    list.splice(list.end(), list, list.begin(), ++ ++ ++list.begin());
+    TEST_ASSERT(list_equals(list, {6, 1, 2, 3, 4, 5, 7, 8, 9, 0}));
+    list2.splice(list2.end(), list, list.begin(), ++ ++list.begin(), 2);
+    TEST_ASSERT(list_equals(list, {2, 3, 4, 5, 7, 8, 9, 0}));
+    TEST_ASSERT(list_equals(list2, {6, 1}));
+
+    // split
+    auto list3 = list.split(++ ++ ++ ++ ++ ++list.begin());
+    TEST_ASSERT(list_equals(list, {2, 3, 4, 5, 7, 8}));
+    TEST_ASSERT(list_equals(list3, {9, 0}));
+    list3.splice(list3.begin(), list.split(list.end()));
+    TEST_ASSERT(list_equals(list3, {9, 0}));
+    list3.splice(list3.begin(), list.split(list.begin()));
+    TEST_ASSERT(list.empty());
+    TEST_ASSERT(list_equals(list3, {2, 3, 4, 5, 7, 8, 9, 0}));
+    list2.clear();
+    list3.clear();
+
+    // without size maintenance
+    nb::IntrusiveList<MyInt, false> list4;
+    nb::IntrusiveList<MyInt, false> list5;
+    list4.insert(list4.begin(), arr.begin(), arr.end());
+    TEST_ASSERT(list4.size() == 10);
+    list5.splice(list5.begin(), list4, ++list4.begin(), --list4.end());
+    TEST_ASSERT(list_equals(list4, {0, 9}));
+    TEST_ASSERT(list_equals(list5, {1, 2, 3, 4, 5, 6, 7, 8}));
+    auto list6 = list5.split(++ ++ ++ ++list5.begin());
+    TEST_ASSERT(list_equals(list5, {1, 2, 3, 4}));
+    TEST_ASSERT(list_equals(list6, {5, 6, 7, 8}));
+    list6.erase(list6.begin(), --list6.end());
+    TEST_ASSERT(list_equals(list6, {8}));
+    list4.splice(++list4.begin(), list5);
+    TEST_ASSERT(list_equals(list4, {0, 1, 2, 3, 4, 9}));
+    TEST_ASSERT(list5.empty());
+    list4.splice(list4.begin(), list6, list6.begin());
+    TEST_ASSERT(list_equals(list4, {8, 0, 1, 2, 3, 4, 9}));
+    TEST_ASSERT(list6.empty());
+
+    // multiple lists
+    std::array<Session, 5> sessions = {0, 1, 2, 3, 4};
+    nb::IntrusiveList<Session> all;
+    nb::IntrusiveList<Session, true, nb::IntrusiveListBaseHook<ZoneTag>> zone;
+    nb::IntrusiveList<Session, false, nb::IntrusiveListBaseHook<DirtyTag>> dirty;
+    for (Session& session : sessions)
+    {
+        all.push_back(session);
+        zone.push_front(session);
+        if (session.num % 2 == 0)
+            dirty.push_back(session);
+    }
+    TEST_ASSERT(list_equals(all, {0, 1, 2, 3, 4}));
+    TEST_ASSERT(list_equals(zone, {4, 3, 2, 1, 0}));
+    TEST_ASSERT(list_equals(dirty, {0, 2, 4}));
+    zone.erase(sessions[2]);
+    dirty.erase(sessions[2]);
+    TEST_ASSERT(list_equals(all, {0, 1, 2, 3, 4}));
+    TEST_ASSERT(list_equals(zone, {4, 3, 1, 0}));
+    TEST_ASSERT(list_equals(dirty, {0, 4}));
+    TEST_ASSERT(&*--dirty.cend() == &sessions[4]);
+
+    // member hook
+    std::array<Timer, 5> timer_objs = {0, 1, 2, 3, 4};
+    nb::IntrusiveList<Timer, true, nb::IntrusiveListMemberHook<&Timer::timer_node>> timers;
+    for (Timer& timer : timer_objs)
+        timers.insert(timers.begin(), timer);
+    TEST_ASSERT(list_equals(timers, {4, 3, 2, 1, 0}));
+    timers.splice(timers.end(), timers, timers.begin());
+    TEST_ASSERT(list_equals(timers, {3, 2, 1, 0, 4}));
+    TEST_ASSERT(&timers.back() == &timer_objs[4]);
+    TEST_ASSERT(&*timers.begin() == &timer_objs[3]);
+    timers.insert(timer_objs[0], timer_objs.begin() + 2, timer_objs.begin() + 2); // empty range
+    TEST_ASSERT(list_equals(timers, {3, 2, 1, 0, 4}));
+
+    // prefetching traversal
+    std::array<MyInt, 10> ints = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    nb::IntrusiveList<MyInt> list7;
+    for (int idx : {7, 2, 9, 0, 5, 3, 8, 1, 6, 4})
+        list7.push_back(ints[static_cast<std::size_t>(idx)]);
+    int sum = 0;
+    list7.for_each_prefetch([&sum](MyInt& val) { sum += val.num; });
+    TEST_ASSERT(sum == 45);
+    sum = 0;
+    std::as_const(list7).for_each_prefetch<1>([&sum](const MyInt& val) { sum = sum * 2 + val.num % 2; });
+    TEST_ASSERT(sum == 0b1010110100);
+    list7.for_each_prefetch<64>([&list7](MyInt& val) {
+        if (val.num == 4 || val.num == 7)
+            list7.erase(val);
+    });
+    TEST_ASSERT(list_equals(list7, {2, 9, 0, 5, 3, 8, 1, 6}));
+    TEST_ASSERT(list7.remove_if_prefetch<2>([](const MyInt& val) { return val.num == 9 || val.num == 6; }) == 2);
+    TEST_ASSERT(list_equals(list7, {2, 0, 5, 3, 8, 1}));
+    TEST_ASSERT(list7.remove_if_prefetch<2>([](const MyInt& val) { return val.num % 3 == 0; }) == 2);
+    TEST_ASSERT(list_equals(list7, {2, 5, 8, 1}));
+    nb::IntrusiveList<MyInt> list8;
+    TEST_ASSERT(list8.remove_if_prefetch([](const MyInt&) { return true; }) == 0);
+    list8.for_each_prefetch([](MyInt&) { TEST_ASSERT(false); });
+
+    // sort
+    list7.sort([](const MyInt& lhs, const MyInt& rhs) { return lhs.num < rhs.num; });
+    TEST_ASSERT(list_equals(list7, {1, 2, 5, 8}));
+    TEST_ASSERT(&list7.front() == &ints[1] && &list7.back() == &ints[8]);
+    list7.sort([](const MyInt& lhs, const MyInt& rhs) { return lhs.num > rhs.num; });
+    TEST_ASSERT(list_equals(list7, {8, 5, 2, 1}));
+    list8.sort_by_address();
+    TEST_ASSERT(list8.empty());
+
+    // stable, so the equal keys stay in insertion order
+    std::array<MyInt, 12> keys = {3, 1, 2, 1, 3, 0, 2, 1, 0, 3, 2, 0};
+    nb::IntrusiveList<MyInt, false> list9;
+    for (MyInt& key : keys)
+        list9.push_front(key);
+    list9.sort([](const MyInt& lhs, const MyInt& rhs) { return lhs.num < rhs.num; });
+    TEST_ASSERT(list_equals(list9, {0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3}));
+    const MyInt* prev_key = nullptr;
+    for (const MyInt& key : list9)
+    {
+        // pushed to front, so the equal keys are in descending address order
+        TEST_ASSERT(!prev_key || prev_key->num != key.num || prev_key > &key);
+        prev_key = &key;
+    }
+    TEST_ASSERT(&*--list9.cend() == &keys[0] && &*std::prev(list9.cend(), 2) == &keys[4]);
+
+    // sort by address restores the memory order
+    list9.sort_by_address();
+    TEST_ASSERT(list_equals(list9, {3, 1, 2, 1, 3, 0, 2, 1, 0, 3, 2, 0}));
+    const MyInt* key_ptr = keys.data();
+    for (const MyInt& key : list9)
+        TEST_ASSERT(&key == key_ptr++);
+    for (auto it = list9.crbegin(); it != list9.crend(); ++it)
+        TEST_ASSERT(&*it == --key_ptr);
+
+    // auto-unlink
+    {
+        using AllList = nb::IntrusiveList<Entity, false, nb::IntrusiveListAutoUnlinkHook<>>;
+        using ZoneList = nb::IntrusiveList<Entity, false, nb::IntrusiveListAutoUnlinkHook<ZoneTag>>;
+        using TimerList = nb::IntrusiveList<TimedEntity, false, nb::IntrusiveListMemberHook<&TimedEntity::timer_node>>;
+        static_assert(AllList::AUTO_UNLINK && ZoneList::AUTO_UNLINK && TimerList::AUTO_UNLINK);
+        static_assert(!nb::IntrusiveList<MyInt>::AUTO_UNLINK);
+        static_assert(std::is_trivially_destructible_v<nb::IntrusiveList<MyInt>>);
+
+        const auto linked = [](const Entity& entity) {
+            return entity.nb::AutoUnlinkIntrusiveListNode<>::is_linked();
+        };
+        const auto zone_linked = [](const Entity& entity) {
+            return entity.nb::AutoUnlinkIntrusiveListNode<ZoneTag>::is_linked();
+        };
+
+        AllList all_entities;
+        TimerList timer_entities;
+        {
+            ZoneList zone_entities;
+            std::array<Entity, 6> entities = {0, 1, 2, 3, 4, 5};
+            for (Entity& entity : entities)
+            {
+                TEST_ASSERT(!linked(entity) && !zone_linked(entity));
+                all_entities.push_back(entity);
+                if (entity.num % 2 == 0)
+                    zone_entities.push_front(entity);
+            }
+            TEST_ASSERT(linked(entities[1]) && !zone_linked(entities[1]));
+            TEST_ASSERT(list_equals(zone_entities, {4, 2, 0}));
+
+            // self-removal in O(1), without the list
+            entities[2].nb::AutoUnlinkIntrusiveListNode<>::unlink();
+            entities[2].nb::AutoUnlinkIntrusiveListNode<>::unlink(); // no-op
+            TEST_ASSERT(!linked(entities[2]) && zone_linked(entities[2]));
+            TEST_ASSERT(list_equals(all_entities, {0, 1, 3, 4, 5}));
+
+            // erasing marks them unlinked, so they can be linked again
+            all_entities.erase(entities[3]);
+            TEST_ASSERT(!linked(entities[3]));
+            all_entities.erase(std::next(all_entities.cbegin()), std::prev(all_entities.cend()));
+            TEST_ASSERT(!linked(entities[1]) && !linked(entities[4]) && linked(entities[5]));
+            TEST_ASSERT(list_equals(all_entities, {0, 5}));
+            all_entities.push_front(entities[3]);
+            TEST_ASSERT(list_equals(all_entities, {3, 0, 5}));
+            TEST_ASSERT(zone_entities.remove_if([](const Entity& entity) { return entity.num == 0; }) == 1);
+            TEST_ASSERT(list_equals(zone_entities, {4, 2}));
+            TEST_ASSERT(!zone_linked(entities[0]));
+
+            // a copy is not linked, and assignment keeps the links
+            Entity copied = entities[5];
+            TEST_ASSERT(!linked(copied) && !zone_linked(copied));
+            copied = entities[0];
+            entities[5] = entities[1];
+            TEST_ASSERT(!linked(copied) && linked(entities[5]) && entities[5].num == 1);
+
+            // splice and swap keep them linked
+            AllList other_entities;
+            other_entities.splice(other_entities.cend(), all_entities);
+            TEST_ASSERT(all_entities.empty() && list_equals(other_entities, {3, 0, 1}));
+            all_entities.swap(other_entities);
+            TEST_ASSERT(linked(entities[0]) && list_equals(all_entities, {3, 0, 1}));
+            TEST_ASSERT(other_entities.empty());
+
+            // destroying a linked node unlinks it
+            {
+                Entity temp(9);
+                all_entities.push_back(temp);
+                TEST_ASSERT(list_equals(all_entities, {3, 0, 1, 9}));
+            }
+            TEST_ASSERT(list_equals(all_entities, {3, 0, 1}));
+
+            all_entities.clear();
+            TEST_ASSERT(!linked(entities[3]) && !linked(entities[0]) && !linked(entities[5]));
+            all_entities.push_back(entities[4]);
+
+            // `entities` are destroyed before the lists, and `zone_entities` is destroyed after nodes are gone
+        }
+        TEST_ASSERT(all_entities.empty());
+
+        // via the member
+        {
+            std::array<TimedEntity, 6> timed_entities = {0, 1, 2, 3, 4, 5};
+            for (TimedEntity& entity : timed_entities)
+            {
+                TEST_ASSERT(!entity.timer_node.is_linked());
+                timer_entities.push_back(entity);
+            }
+            TEST_ASSERT(timed_entities[1].timer_node.is_linked());
+
+            timed_entities[2].timer_node.unlink();
+            timed_entities[2].timer_node.unlink(); // no-op
+            TEST_ASSERT(!timed_entities[2].timer_node.is_linked());
+            TEST_ASSERT(list_equals(timer_entities, {0, 1, 3, 4, 5}));
+
+            TimedEntity copied = timed_entities[5];
+            TEST_ASSERT(!copied.timer_node.is_linked());
+            timer_entities.erase(timed_entities[0]);
+            TEST_ASSERT(!timed_entities[0].timer_node.is_linked());
+            {
+                TimedEntity temp(9);
+                timer_entities.push_front(temp);
+                TEST_ASSERT(list_equals(timer_entities, {9, 1, 3, 4, 5}));
+                TEST_ASSERT(&timer_entities.front() == &temp && &timer_entities.back() == &timed_entities[5]);
+            }
+            TEST_ASSERT(list_equals(timer_entities, {1, 3, 4, 5}));
+        }
+        TEST_ASSERT(timer_entities.empty());
+
+        // the list going away first marks the nodes unlinked
+        Entity survivor(7);
+        {
+            ZoneList zone_entities;
+            zone_entities.push_back(survivor);
+            TEST_ASSERT(zone_linked(survivor));
+        }
+        TEST_ASSERT(!zone_linked(survivor));
+    }
+
     std::cout << "All is well!" << std::endl;
 }
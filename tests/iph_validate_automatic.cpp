@@ -0,0 +1,196 @@
+#include "NetBuff/IntrusivePairingHeap.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <source_location>
+#include <utility>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed " << #condition << " at phase #" << phase << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+namespace
+{
+
+constexpr int PHASES = 300000;
+
+struct Task : public nb::IntrusivePairingHeapNode
+{
+    int key;
+    std::size_t id;
+    bool queued = false;
+};
+
+struct TaskOrder
+{
+    bool operator()(const Task& lhs, const Task& rhs) const
+    {
+        return lhs.key < rhs.key;
+    }
+};
+
+using TaskHeap = nb::IntrusivePairingHeap<Task, TaskOrder>;
+
+// (key, id)
+using RefHeap = std::set<std::pair<int, std::size_t>>;
+
+void validate(std::mt19937& rng, const std::size_t task_count, const int key_range)
+{
+    std::vector<Task> tasks(task_count);
+    for (std::size_t id = 0; id < task_count; ++id)
+        tasks[id].id = id;
+
+    TaskHeap heap;
+    RefHeap ref;
+
+    std::uniform_int_distribution<int> key_dist(0, key_range - 1);
+    std::uniform_int_distribution<std::size_t> id_dist(0, task_count - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    for (int phase = 1; phase <= PHASES; ++phase)
+    {
+        const int action = percent(rng);
+        Task& task = tasks[id_dist(rng)];
+
+        if (action < 40) // push
+        {
+            if (!task.queued)
+            {
+                task.key = key_dist(rng);
+                task.queued = true;
+                heap.push(task);
+                ref.emplace(task.key, task.id);
+            }
+        }
+        else if (action < 70) // pop
+        {
+            if (!heap.empty())
+            {
+                Task& popped = heap.pop();
+                // equal keys pop in unspecified order
+                TEST_ASSERT(popped.key == ref.begin()->first);
+                TEST_ASSERT(popped.queued);
+                TEST_ASSERT(ref.erase({popped.key, popped.id}) == 1);
+                popped.queued = false;
+            }
+        }
+        else if (action < 80) // erase
+        {
+            if (task.queued)
+            {
+                heap.erase(task);
+                ref.erase({task.key, task.id});
+                task.queued = false;
+            }
+        }
+        else if (action < 88) // decrease
+        {
+            if (task.queued && task.key > 0)
+            {
+                ref.erase({task.key, task.id});
+                task.key -= std::uniform_int_distribution<int>(1, task.key)(rng);
+                ref.emplace(task.key, task.id);
+                heap.decrease(task);
+            }
+        }
+        else if (action < 96) // update
+        {
+            if (task.queued)
+            {
+                ref.erase({task.key, task.id});
+                task.key = key_dist(rng);
+                ref.emplace(task.key, task.id);
+                heap.update(task);
+            }
+        }
+        else if (action < 99) // split off & merge back
+        {
+            TaskHeap other;
+            for (int count = percent(rng) % 8; count > 0 && !heap.empty(); --count)
+            {
+                Task& moved = heap.pop();
+                other.push(moved);
+            }
+            const std::size_t other_size = other.size();
+            const std::size_t heap_size = heap.size();
+            if (percent(rng) < 50)
+            {
+                heap.merge(other);
+            }
+            else
+            {
+                other.merge(std::move(heap));
+                TEST_ASSERT(heap.empty() && heap.size() == 0);
+                heap = std::move(other);
+            }
+            TEST_ASSERT(heap.size() == heap_size + other_size);
+        }
+        else // drain
+        {
+            int prev_key = -1;
+            while (!heap.empty())
+            {
+                Task& popped = heap.pop();
+                TEST_ASSERT(prev_key <= popped.key);
+                prev_key = popped.key;
+                popped.queued = false;
+            }
+            ref.clear();
+        }
+
+        TEST_ASSERT(heap.size() == ref.size());
+        TEST_ASSERT(heap.empty() == ref.empty());
+        if (!heap.empty())
+            TEST_ASSERT(heap.top().key == ref.begin()->first);
+    }
+
+    // pops in order
+    {
+        constexpr int phase = PHASES + 1;
+
+        TaskHeap moved(std::move(heap));
+        TEST_ASSERT(heap.empty());
+        while (!moved.empty())
+        {
+            Task& popped = moved.pop();
+            TEST_ASSERT(popped.key == ref.begin()->first);
+            TEST_ASSERT(ref.erase({popped.key, popped.id}) == 1);
+        }
+        TEST_ASSERT(ref.empty());
+    }
+}
+
+} // namespace
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    std::mt19937 rng(seed);
+
+    validate(rng, 1, 4);
+    validate(rng, 64, 16);
+    validate(rng, 1000, 1000000);
+    validate(rng, 5000, 100);
+
+    std::cout << "All is well!" << std::endl;
+}
@@ -0,0 +1,110 @@
+#include "NetBuff/IntrusiveSList.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <source_location>
+#include <utility>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed: " << #condition << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::exit(1); \
+        } \
+    } while (false)
+
+struct MyInt : public nb::IntrusiveSListNode
+{
+    int num;
+
+    MyInt(int num_) : num(num_)
+    {
+    }
+};
+
+static_assert(sizeof(nb::IntrusiveSListNode) == sizeof(void*));
+
+bool list_equals(const nb::IntrusiveSList<MyInt>& intru_list, std::initializer_list<int> init_list)
+{
+    if (intru_list.size() != init_list.size())
+        return false;
+
+    auto it_intru = intru_list.cbegin();
+    auto it_init = init_list.begin();
+
+    while (it_intru != intru_list.cend())
+    {
+        if (it_intru->num != *it_init)
+            return false;
+
+        ++it_intru;
+        ++it_init;
+    }
+
+    return init_list.size() == 0 || intru_list.back().num == *(init_list.end() - 1);
+}
+
+int main()
+{
+    std::array<MyInt, 10> arr = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    nb::IntrusiveSList<MyInt> list;
+    TEST_ASSERT(list.empty());
+    TEST_ASSERT(list.cbegin() == list.end());
+    list.push_back(arr[1]);
+    TEST_ASSERT(&list.front() == &arr[1]);
+    TEST_ASSERT(&list.back() == &arr[1]);
+    list.pop_front();
+    TEST_ASSERT(list.empty());
+    list.push_front(arr[1]);
+    list.push_front(arr[0]);
+    list.push_back(arr[2]);
+    TEST_ASSERT(list_equals(list, {0, 1, 2}));
+    list.insert_after(list.begin(), arr[5]);
+    list.insert_after(arr[2], arr[3]);
+    TEST_ASSERT(list_equals(list, {0, 5, 1, 2, 3}));
+    TEST_ASSERT(list.erase_after(list.begin())->num == 1);
+    TEST_ASSERT(list_equals(list, {0, 1, 2, 3}));
+    TEST_ASSERT(list.erase_after(++ ++list.begin()) == list.end()); // erase the back
+    TEST_ASSERT(list_equals(list, {0, 1, 2}));
+    list.push_back(arr[3]);
+    TEST_ASSERT(list_equals(list, {0, 1, 2, 3}));
+
+    // splice
+    nb::IntrusiveSList<MyInt> list2;
+    list2.push_back(arr[4]);
+    list2.push_back(arr[5]);
+    list.splice_back(list2);
+    TEST_ASSERT(list2.empty());
+    TEST_ASSERT(list_equals(list, {0, 1, 2, 3, 4, 5}));
+    list2.splice_back(list);
+    TEST_ASSERT(list.empty());
+    TEST_ASSERT(list_equals(list2, {0, 1, 2, 3, 4, 5}));
+    list.splice_back(nb::IntrusiveSList<MyInt>());
+    TEST_ASSERT(list.empty());
+
+    // move
+    nb::IntrusiveSList<MyInt> list3(std::move(list2));
+    TEST_ASSERT(list2.empty());
+    TEST_ASSERT(list_equals(list3, {0, 1, 2, 3, 4, 5}));
+    list3.pop_front();
+    list3.pop_front();
+    list2 = std::move(list3);
+    TEST_ASSERT(list3.empty());
+    TEST_ASSERT(list_equals(list2, {2, 3, 4, 5}));
+    while (!list2.empty())
+        list2.pop_front();
+    TEST_ASSERT(0 == list2.size());
+    list2.push_back(arr[9]);
+    TEST_ASSERT(list_equals(list2, {9}));
+    list2.clear();
+    TEST_ASSERT(list2.empty());
+
+    std::cout << "All is well!" << std::endl;
+}
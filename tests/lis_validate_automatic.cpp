@@ -0,0 +1,139 @@
+#include "NetBuff/LockfreeIntrusiveStack.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <source_location>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::ostringstream oss; \
+            oss << "Failed " << #condition << "\n"; \
+            const auto loc = std::source_location::current(); \
+            oss << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << oss.str() << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+constexpr int PHASES = 20;
+constexpr int OPS_PER_THREAD = 20000;
+constexpr std::size_t ITEMS = 1000;
+
+struct Item : public nb::IntrusiveSListNode
+{
+    std::atomic<bool> popped = false; // detects an item popped twice
+    int value = 0;
+};
+
+void worker(nb::LockfreeIntrusiveStack<Item>& stack, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    std::vector<Item*> owned;
+
+    auto take = [&owned](Item* item) {
+        TEST_ASSERT(!item->popped.exchange(true, std::memory_order_relaxed));
+        ++item->value; // owned exclusively
+        owned.push_back(item);
+    };
+
+    for (int op = 0; op < OPS_PER_THREAD; ++op)
+    {
+        const int action = percent(rng);
+        if (action < 45)
+        {
+            if (Item* item = stack.try_pop())
+                take(item);
+        }
+        else if (action < 50)
+        {
+            nb::IntrusiveSList<Item> list = stack.pop_all();
+            for (Item& item : list)
+                take(&item);
+        }
+        else if (!owned.empty())
+        {
+            // give back one, or many at once
+            if (action < 90)
+            {
+                owned.back()->popped.store(false, std::memory_order_relaxed);
+                stack.push(*owned.back());
+                owned.pop_back();
+            }
+            else
+            {
+                nb::IntrusiveSList<Item> list;
+                while (!owned.empty())
+                {
+                    owned.back()->popped.store(false, std::memory_order_relaxed);
+                    list.push_front(*owned.back());
+                    owned.pop_back();
+                }
+                stack.push(list);
+                TEST_ASSERT(list.empty());
+            }
+        }
+    }
+
+    for (Item* item : owned)
+    {
+        item->popped.store(false, std::memory_order_relaxed);
+        stack.push(*item);
+    }
+}
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    // oversubscribe a bit, to interleave even on few cores
+    const unsigned cores = std::max(4u, std::thread::hardware_concurrency());
+    std::cout << "Preparing " << cores << " concurrent threads...\n";
+
+    std::deque<Item> items(ITEMS);
+    nb::LockfreeIntrusiveStack<Item> stack;
+    TEST_ASSERT(stack.empty());
+
+    for (Item& item : items)
+        stack.push(item);
+    TEST_ASSERT(!stack.empty());
+
+    for (int phase = 1; phase <= PHASES; ++phase)
+    {
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < cores; ++i)
+            threads.emplace_back(worker, std::ref(stack), seed + phase * cores + i);
+        for (auto& t : threads)
+            t.join();
+
+        // every item is back exactly once
+        nb::IntrusiveSList<Item> all = stack.pop_all();
+        TEST_ASSERT(stack.empty());
+        TEST_ASSERT(ITEMS == all.size());
+        for (Item& item : all)
+            TEST_ASSERT(!item.popped.exchange(true));
+        for (Item& item : all)
+            item.popped = false;
+
+        stack.push(all);
+    }
+
+    std::cout << "All is well!" << std::endl;
+}
@@ -0,0 +1,325 @@
+#include <benchmark/benchmark.h>
+
+#define NB_OBJ_POOL_CHECK false
+#include "NetBuff/LockfreeObjectPool.hpp"
+#include "NetBuff/ObjectPool.hpp"
+
+#include "NetBuff/LockfreeIntrusiveStack.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr int BATCH = 64;
+constexpr std::size_t RESERVE = 1 << 16;
+
+// timing every operation would measure mostly the clock
+constexpr std::uint32_t LATENCY_SAMPLE_INTERVAL = 16;
+
+struct Payload : public nb::IntrusiveSListNode
+{
+    std::uint32_t shard;
+    std::byte data[52];
+};
+
+class NewDeletePool
+{
+public:
+    auto construct() -> Payload&
+    {
+        return *new Payload();
+    }
+
+    void destroy(Payload& obj)
+    {
+        delete &obj;
+    }
+};
+
+class LockfreePool
+{
+public:
+    auto construct() -> Payload&
+    {
+        return _pool.construct();
+    }
+
+    void destroy(Payload& obj)
+    {
+        _pool.destroy(obj);
+    }
+
+private:
+    nb::LockfreeObjectPool<Payload, true> _pool{RESERVE};
+};
+
+class MutexPool
+{
+public:
+    auto construct() -> Payload&
+    {
+        std::lock_guard lock(_mutex);
+        return _pool.construct();
+    }
+
+    void destroy(Payload& obj)
+    {
+        std::lock_guard lock(_mutex);
+        _pool.destroy(obj);
+    }
+
+private:
+    std::mutex _mutex;
+    nb::ObjectPool<Payload, true> _pool{RESERVE};
+};
+
+/// @brief Threads are spread over the shards, and each object goes back to the shard it came from.
+auto this_thread_shard(std::uint32_t shard_count) -> std::uint32_t
+{
+    static std::atomic<std::uint32_t> next_thread = 0;
+    thread_local const std::uint32_t thread = next_thread.fetch_add(1, std::memory_order_relaxed);
+    return thread % shard_count;
+}
+
+/// @brief `LockfreeObjectPool` per shard, so that only the threads sharing a shard contend on its head.
+class ShardedLockfreePool
+{
+public:
+    static constexpr std::uint32_t SHARD_COUNT = 16;
+
+    ShardedLockfreePool()
+    {
+        for (auto& shard : _shards)
+            shard = std::make_unique<nb::LockfreeObjectPool<Payload, true>>(RESERVE / SHARD_COUNT);
+    }
+
+    auto construct() -> Payload&
+    {
+        const std::uint32_t shard = this_thread_shard(SHARD_COUNT);
+        Payload& obj = _shards[shard]->construct();
+        obj.shard = shard;
+        return obj;
+    }
+
+    void destroy(Payload& obj)
+    {
+        _shards[obj.shard]->destroy(obj);
+    }
+
+private:
+    std::array<std::unique_ptr<nb::LockfreeObjectPool<Payload, true>>, SHARD_COUNT> _shards;
+};
+
+/// @brief Shared by all threads & runs of a benchmark, all objects are returned at the end of each run.
+template <typename Pool>
+auto shared_pool() -> Pool&
+{
+    static Pool pool;
+    return pool;
+}
+
+/// @brief Median time taken by a pair of `steady_clock::now()` calls, i.e. what the clock adds to each sample.
+auto clock_overhead_ns() -> double
+{
+    static const double overhead = [] {
+        std::vector<double> durations(1000);
+        for (double& duration : durations)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const auto end = std::chrono::steady_clock::now();
+            duration = std::chrono::duration<double, std::nano>(end - start).count();
+        }
+
+        const auto median = durations.begin() + durations.size() / 2;
+        std::nth_element(durations.begin(), median, durations.end());
+        return *median;
+    }();
+
+    return overhead;
+}
+
+/// @brief Latencies of every `LATENCY_SAMPLE_INTERVAL`th operation of a thread, without the clock overhead.
+class LatencySamples
+{
+public:
+    /// @param expected_ops Operations to be run, to reserve the samples up front,
+    /// as reallocating in the timed loop would show up in the latencies
+    explicit LatencySamples(std::int64_t expected_ops) : _clock_overhead(clock_overhead_ns())
+    {
+        _samples.reserve(static_cast<std::size_t>(expected_ops) / LATENCY_SAMPLE_INTERVAL + 1);
+    }
+
+    template <typename Op>
+    void run(Op&& op)
+    {
+        if (_count++ % LATENCY_SAMPLE_INTERVAL != 0)
+        {
+            op();
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        op();
+        const auto end = std::chrono::steady_clock::now();
+        const double latency = std::chrono::duration<double, std::nano>(end - start).count() - _clock_overhead;
+        _samples.push_back(std::max(0.0, latency));
+    }
+
+    void merge(const LatencySamples& other)
+    {
+        _samples.insert(_samples.end(), other._samples.begin(), other._samples.end());
+    }
+
+    void clear()
+    {
+        _samples.clear();
+    }
+
+    auto percentile(double ratio) -> double
+    {
+        if (_samples.empty())
+            return 0;
+
+        const auto rank = static_cast<std::ptrdiff_t>(ratio * static_cast<double>(_samples.size() - 1));
+        const auto nth = _samples.begin() + rank;
+        std::nth_element(_samples.begin(), nth, _samples.end());
+        return *nth;
+    }
+
+private:
+    std::vector<double> _samples;
+    std::uint32_t _count = 0;
+    double _clock_overhead;
+};
+
+/// @brief Called by every thread at the end of a run.
+///
+/// The latencies of all threads are merged, and the last thread to merge reports their percentiles.
+/// (counters are summed over threads, so the other threads don't set them)
+void set_counters(benchmark::State& state, std::int64_t ops, const LatencySamples& construct_latency,
+                  const LatencySamples& destroy_latency)
+{
+    static std::mutex mutex;
+    static LatencySamples all_construct_latency(0), all_destroy_latency(0);
+    static int merged_threads = 0;
+
+    state.SetItemsProcessed(ops);
+    state.counters["ops_per_thread"] =
+        benchmark::Counter(static_cast<double>(ops), benchmark::Counter::kIsRate | benchmark::Counter::kAvgThreads);
+
+    std::lock_guard lock(mutex);
+    all_construct_latency.merge(construct_latency);
+    all_destroy_latency.merge(destroy_latency);
+    if (++merged_threads < state.threads())
+        return;
+
+    state.counters["construct_p99_ns"] = all_construct_latency.percentile(0.99);
+    state.counters["destroy_p99_ns"] = all_destroy_latency.percentile(0.99);
+
+    all_construct_latency.clear();
+    all_destroy_latency.clear();
+    merged_threads = 0;
+}
+
+/// @brief 1, then powers of 2 up to the number of hardware threads, which are even for `producer_consumer`.
+constexpr auto thread_counts = [](auto* bench) {
+    const unsigned max_threads = std::max(2u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2)
+        bench->Threads(static_cast<int>(threads));
+};
+
+} // namespace
+
+/// @brief Each thread constructs a batch of objects, and destroys them by itself.
+template <typename Pool>
+void local_alloc_free(benchmark::State& state)
+{
+    Pool& pool = shared_pool<Pool>();
+    std::array<Payload*, BATCH> objs;
+    LatencySamples construct_latency(state.max_iterations * BATCH), destroy_latency(state.max_iterations * BATCH);
+    std::int64_t ops = 0;
+
+    for (auto _ : state)
+    {
+        for (Payload*& obj : objs)
+            construct_latency.run([&] { obj = &pool.construct(); });
+        benchmark::DoNotOptimize(objs.data());
+        for (Payload* obj : objs)
+            destroy_latency.run([&] { pool.destroy(*obj); });
+
+        ops += 2 * BATCH;
+    }
+
+    set_counters(state, ops, construct_latency, destroy_latency);
+}
+
+/// @brief Even threads construct objects and hand them over to odd threads, which destroy them.
+///
+/// So objects are always destroyed by another thread, like packets passed from I/O threads to logic threads.
+/// With a single thread, it does both.
+template <typename Pool>
+void producer_consumer(benchmark::State& state)
+{
+    static nb::LockfreeIntrusiveStack<Payload> handoff;
+
+    Pool& pool = shared_pool<Pool>();
+    const bool produce = state.threads() == 1 || state.thread_index() % 2 == 0;
+    const bool consume = state.threads() == 1 || state.thread_index() % 2 == 1;
+    LatencySamples construct_latency(state.max_iterations * BATCH), destroy_latency(state.max_iterations * BATCH);
+    std::int64_t ops = 0;
+
+    for (auto _ : state)
+    {
+        if (produce)
+        {
+            for (int count = 0; count < BATCH; ++count)
+            {
+                Payload* obj;
+                construct_latency.run([&] { obj = &pool.construct(); });
+                handoff.push(*obj);
+            }
+            ops += BATCH;
+        }
+
+        if (consume)
+        {
+            for (int count = 0; count < BATCH;)
+            {
+                if (Payload* obj = handoff.try_pop())
+                {
+                    destroy_latency.run([&] { pool.destroy(*obj); });
+                    ++count;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+            ops += BATCH;
+        }
+    }
+
+    set_counters(state, ops, construct_latency, destroy_latency);
+}
+
+BENCHMARK_TEMPLATE(local_alloc_free, NewDeletePool)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(local_alloc_free, MutexPool)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(local_alloc_free, LockfreePool)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(local_alloc_free, ShardedLockfreePool)->Apply(thread_counts)->UseRealTime();
+
+BENCHMARK_TEMPLATE(producer_consumer, NewDeletePool)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(producer_consumer, MutexPool)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(producer_consumer, LockfreePool)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_TEMPLATE(producer_consumer, ShardedLockfreePool)->Apply(thread_counts)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,212 @@
+#include "NetBuff/LruCache.hpp"
+#include "NetBuff/ObjectPool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <random>
+#include <source_location>
+#include <unordered_map>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed " << #condition << " at phase #" << phase << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+namespace
+{
+
+constexpr int PHASES = 300000;
+
+struct Entry : public nb::LruCacheNode
+{
+    Entry(int key_, int value_) : key(key_), value(value_)
+    {
+    }
+
+    int key;
+    int value;
+};
+
+struct EntryKey
+{
+    auto operator()(const Entry& entry) const -> const int&
+    {
+        return entry.key;
+    }
+};
+
+// collides a lot, to exercise probing & backward shift deletion
+struct BadHash
+{
+    auto operator()(int key) const -> std::size_t
+    {
+        return static_cast<std::size_t>(key % 7);
+    }
+};
+
+template <typename Hash>
+void validate(std::mt19937& rng, const std::size_t capacity, const int key_range)
+{
+    nb::ObjectPool<Entry, true> pool(capacity + 1);
+    nb::LruCache<int, Entry, EntryKey, Hash> cache(capacity);
+
+    // reference: most recently used first
+    std::list<std::pair<int, int>> ref_list;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> ref_map;
+
+    std::uniform_int_distribution<int> key_dist(0, key_range - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    for (int phase = 1; phase <= PHASES; ++phase)
+    {
+        const int key = key_dist(rng);
+        const int action = percent(rng);
+
+        if (action < 50) // get or insert
+        {
+            Entry* entry = cache.find(key);
+            const auto ref_it = ref_map.find(key);
+            TEST_ASSERT((entry != nullptr) == (ref_it != ref_map.end()));
+
+            if (entry)
+            {
+                TEST_ASSERT(key == entry->key);
+                TEST_ASSERT(ref_it->second->second == entry->value);
+                ref_list.splice(ref_list.begin(), ref_list, ref_it->second);
+            }
+            else
+            {
+                Entry& new_entry = pool.construct(key, phase);
+                Entry* evicted = cache.insert(new_entry);
+
+                TEST_ASSERT((evicted != nullptr) == (ref_list.size() == capacity));
+                if (evicted)
+                {
+                    TEST_ASSERT(ref_list.back().first == evicted->key);
+                    ref_map.erase(ref_list.back().first);
+                    ref_list.pop_back();
+                    pool.destroy(*evicted);
+                }
+
+                ref_list.emplace_front(key, phase);
+                ref_map[key] = ref_list.begin();
+            }
+        }
+        else if (action < 70) // peek
+        {
+            const Entry* entry = cache.peek(key);
+            const auto ref_it = ref_map.find(key);
+            TEST_ASSERT((entry != nullptr) == (ref_it != ref_map.end()));
+            TEST_ASSERT(cache.contains(key) == (entry != nullptr));
+            if (entry)
+                TEST_ASSERT(ref_it->second->second == entry->value);
+        }
+        else if (action < 80) // erase by key
+        {
+            Entry* entry = cache.erase(key);
+            const auto ref_it = ref_map.find(key);
+            TEST_ASSERT((entry != nullptr) == (ref_it != ref_map.end()));
+            if (entry)
+            {
+                TEST_ASSERT(!cache.contains(key));
+                ref_list.erase(ref_it->second);
+                ref_map.erase(ref_it);
+                pool.destroy(*entry);
+            }
+        }
+        else if (action < 90) // erase by reference
+        {
+            if (!cache.empty())
+            {
+                Entry& entry = (percent(rng) < 50) ? cache.lru() : cache.mru();
+                const int erased_key = entry.key;
+                cache.erase(entry);
+                TEST_ASSERT(!cache.contains(erased_key));
+
+                ref_list.erase(ref_map[erased_key]);
+                ref_map.erase(erased_key);
+                pool.destroy(entry);
+            }
+        }
+        else if (action < 99) // pop the least recently used
+        {
+            if (!cache.empty())
+            {
+                Entry& entry = cache.pop_lru();
+                TEST_ASSERT(ref_list.back().first == entry.key);
+                ref_map.erase(entry.key);
+                ref_list.pop_back();
+                pool.destroy(entry);
+            }
+        }
+        else // clear
+        {
+            while (!cache.empty())
+                pool.destroy(cache.pop_lru());
+            ref_list.clear();
+            ref_map.clear();
+        }
+
+        TEST_ASSERT(ref_list.size() == cache.size());
+        TEST_ASSERT(pool.used_slots() == cache.size());
+        TEST_ASSERT(cache.size() <= cache.capacity());
+    }
+
+    // recency order
+    {
+        constexpr int phase = PHASES + 1;
+
+        auto ref_it = ref_list.begin();
+        for (const Entry& entry : cache)
+        {
+            TEST_ASSERT(ref_it->first == entry.key);
+            ++ref_it;
+        }
+        TEST_ASSERT(ref_list.end() == ref_it);
+
+        // moved cache keeps everything
+        auto moved = std::move(cache);
+        TEST_ASSERT(cache.empty());
+        TEST_ASSERT(ref_list.size() == moved.size());
+        for (const auto& [key, value] : ref_list)
+            TEST_ASSERT(value == moved.peek(key)->value);
+
+        // every entry goes back to the pool
+        while (!moved.empty())
+            pool.destroy(moved.pop_lru());
+        TEST_ASSERT(0 == pool.used_slots());
+        TEST_ASSERT(capacity + 1 == pool.capacity());
+    }
+}
+
+} // namespace
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    std::mt19937 rng(seed);
+
+    validate<std::hash<int>>(rng, 1, 4);
+    validate<std::hash<int>>(rng, 64, 100);
+    validate<std::hash<int>>(rng, 1000, 3000);
+    validate<BadHash>(rng, 50, 200);
+
+    std::cout << "All is well!" << std::endl;
+}
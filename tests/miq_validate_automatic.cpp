@@ -0,0 +1,113 @@
+#include "NetBuff/MpscIntrusiveQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <source_location>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::ostringstream oss; \
+            oss << "Failed " << #condition << "\n"; \
+            const auto loc = std::source_location::current(); \
+            oss << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << oss.str() << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+constexpr int PHASES = 20;
+constexpr std::size_t ITEMS_PER_PRODUCER = 20000;
+
+struct Item : public nb::IntrusiveSListNode
+{
+    unsigned producer;
+    std::size_t seq;
+};
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    // oversubscribe a bit, to interleave even on few cores
+    const unsigned producers = std::max(3u, std::thread::hardware_concurrency() - 1);
+    std::cout << "Preparing " << producers << " producers & a consumer...\n";
+
+    std::vector<std::deque<Item>> items(producers);
+    for (auto& producer_items : items)
+        producer_items.resize(ITEMS_PER_PRODUCER);
+
+    nb::MpscIntrusiveQueue<Item> queue;
+    TEST_ASSERT(queue.empty());
+    TEST_ASSERT(!queue.try_pop());
+
+    // single thread
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+            queue.push(items[0][i]);
+        TEST_ASSERT(!queue.empty());
+        for (std::size_t i = 0; i < 3; ++i)
+            TEST_ASSERT(&items[0][i] == queue.try_pop());
+        TEST_ASSERT(queue.empty());
+        TEST_ASSERT(!queue.try_pop());
+    }
+
+    for (int phase = 1; phase <= PHASES; ++phase)
+    {
+        std::vector<std::thread> threads;
+        for (unsigned p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&queue, &items, p, seed = seed + phase * producers + p]() {
+                std::mt19937 rng(seed);
+                for (std::size_t i = 0; i < ITEMS_PER_PRODUCER; ++i)
+                {
+                    items[p][i].producer = p;
+                    items[p][i].seq = i;
+                    queue.push(items[p][i]);
+
+                    if (rng() % 1000 == 0)
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        // FIFO per producer
+        std::vector<std::size_t> next_seq(producers, 0);
+        std::size_t popped = 0;
+        while (popped < producers * ITEMS_PER_PRODUCER)
+        {
+            Item* item = queue.try_pop();
+            if (!item)
+                continue;
+
+            TEST_ASSERT(item->producer < producers);
+            TEST_ASSERT(next_seq[item->producer] == item->seq);
+            TEST_ASSERT(&items[item->producer][item->seq] == item);
+            ++next_seq[item->producer];
+            ++popped;
+        }
+
+        for (auto& t : threads)
+            t.join();
+
+        TEST_ASSERT(queue.empty());
+        TEST_ASSERT(!queue.try_pop());
+    }
+
+    std::cout << "All is well!" << std::endl;
+}
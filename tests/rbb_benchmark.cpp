@@ -0,0 +1,264 @@
+#include <benchmark/benchmark.h>
+
+#include "NetBuff/RingByteBuffer.hpp"
+#include "NetBuff/SpscRingByteBuffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+
+constexpr std::size_t RING_CAPACITY = 64 * 1024;
+constexpr std::int64_t MESSAGES_PER_ITERATION = 100000;
+
+/// @brief Byte queue with the same interface as the ring buffers, for comparison.
+///
+/// This is what you'd write without them: a `std::deque<std::byte>` behind a mutex.
+class MutexDequeByteQueue
+{
+public:
+    explicit MutexDequeByteQueue(std::size_t capacity) : _capacity(capacity)
+    {
+    }
+
+    bool try_write(const void* data, std::size_t length)
+    {
+        std::lock_guard lock(_mutex);
+
+        if (length > _capacity - _bytes.size())
+            return false;
+
+        const auto* bytes = static_cast<const std::byte*>(data);
+        _bytes.insert(_bytes.end(), bytes, bytes + length);
+        return true;
+    }
+
+    bool try_read(void* dest, std::size_t length)
+    {
+        std::lock_guard lock(_mutex);
+
+        if (length > _bytes.size())
+            return false;
+
+        const auto end = _bytes.begin() + static_cast<std::ptrdiff_t>(length);
+        std::copy(_bytes.begin(), end, static_cast<std::byte*>(dest));
+        _bytes.erase(_bytes.begin(), end);
+        return true;
+    }
+
+private:
+    std::mutex _mutex;
+    std::deque<std::byte> _bytes;
+    std::size_t _capacity;
+};
+
+/// @brief Pins the calling thread to `cpu` while it's alive, and restores the previous affinity on destruction.
+///
+/// So the benchmark thread isn't left pinned for the following benchmarks.
+/// Pinning is skipped if there aren't enough CPUs to run both threads on their own, or the affinity can't be set.
+class ScopedPin
+{
+public:
+    explicit ScopedPin([[maybe_unused]] unsigned cpu)
+    {
+#if defined(__linux__)
+        if (std::thread::hardware_concurrency() < 2)
+            return;
+        if (pthread_getaffinity_np(pthread_self(), sizeof(_prev_cpu_set), &_prev_cpu_set) != 0)
+            return;
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        _pinned = (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0);
+#endif
+    }
+
+    ~ScopedPin()
+    {
+#if defined(__linux__)
+        if (_pinned)
+            pthread_setaffinity_np(pthread_self(), sizeof(_prev_cpu_set), &_prev_cpu_set);
+#endif
+    }
+
+    ScopedPin(const ScopedPin&) = delete;
+    ScopedPin& operator=(const ScopedPin&) = delete;
+
+private:
+#if defined(__linux__)
+    cpu_set_t _prev_cpu_set;
+    bool _pinned = false;
+#endif
+};
+
+void set_counters(benchmark::State& state, std::int64_t messages, std::size_t message_size)
+{
+    state.SetItemsProcessed(messages);
+    state.SetBytesProcessed(messages * static_cast<std::int64_t>(message_size));
+}
+
+} // namespace
+
+/// @brief Writes messages until full, then reads all of them.
+template <typename Queue>
+void fill_drain(benchmark::State& state)
+{
+    const auto message_size = static_cast<std::size_t>(state.range(0));
+    const std::size_t messages_per_fill = RING_CAPACITY / message_size;
+    std::vector<std::byte> message(message_size, std::byte(0x5A));
+    std::vector<std::byte> received(message_size);
+
+    Queue queue(RING_CAPACITY);
+    std::int64_t messages = 0;
+
+    for (auto _ : state)
+    {
+        for (std::size_t count = 0; count < messages_per_fill; ++count)
+            queue.try_write(message.data(), message_size);
+        for (std::size_t count = 0; count < messages_per_fill; ++count)
+            queue.try_read(received.data(), message_size);
+
+        benchmark::DoNotOptimize(received.data());
+        messages += static_cast<std::int64_t>(messages_per_fill);
+    }
+
+    set_counters(state, messages, message_size);
+}
+
+/// @brief Writes & reads a message at a time, with a capacity which isn't a multiple of the message size.
+///
+/// So about 2 in 5 messages are split around the end, and take the 2-phase copy.
+template <typename Queue>
+void wrap_heavy(benchmark::State& state)
+{
+    const auto message_size = static_cast<std::size_t>(state.range(0));
+    std::vector<std::byte> message(message_size, std::byte(0x5A));
+    std::vector<std::byte> received(message_size);
+
+    Queue queue(message_size * 5 / 2);
+    std::int64_t messages = 0;
+
+    for (auto _ : state)
+    {
+        for (std::int64_t count = 0; count < 1000; ++count)
+        {
+            queue.try_write(message.data(), message_size);
+            queue.try_read(received.data(), message_size);
+        }
+
+        benchmark::DoNotOptimize(received.data());
+        messages += 1000;
+    }
+
+    set_counters(state, messages, message_size);
+}
+
+/// @brief Producer thread writes messages, while the benchmark thread reads them.
+template <typename Queue>
+void producer_consumer(benchmark::State& state)
+{
+    const auto message_size = static_cast<std::size_t>(state.range(0));
+    std::vector<std::byte> received(message_size);
+
+    Queue queue(RING_CAPACITY);
+    std::atomic<bool> stop = false;
+
+    std::thread producer([&queue, &stop, message_size] {
+        const ScopedPin pin(1);
+        std::vector<std::byte> message(message_size, std::byte(0x5A));
+
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            if (!queue.try_write(message.data(), message_size))
+                std::this_thread::yield();
+        }
+    });
+    const ScopedPin pin(0);
+
+    std::int64_t messages = 0;
+    for (auto _ : state)
+    {
+        for (std::int64_t count = 0; count < MESSAGES_PER_ITERATION;)
+        {
+            if (queue.try_read(received.data(), message_size))
+                ++count;
+            else
+                std::this_thread::yield();
+        }
+
+        benchmark::DoNotOptimize(received.data());
+        messages += MESSAGES_PER_ITERATION;
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    producer.join();
+
+    set_counters(state, messages, message_size);
+}
+
+/// @brief Sends a message to the echo thread and waits for it to come back, so the time is the round trip latency.
+template <typename Queue>
+void round_trip(benchmark::State& state)
+{
+    const auto message_size = static_cast<std::size_t>(state.range(0));
+    std::vector<std::byte> message(message_size, std::byte(0x5A));
+
+    Queue request(RING_CAPACITY);
+    Queue response(RING_CAPACITY);
+    std::atomic<bool> stop = false;
+
+    std::thread echo([&request, &response, &stop, message_size] {
+        const ScopedPin pin(1);
+        std::vector<std::byte> echoed(message_size);
+
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            if (request.try_read(echoed.data(), message_size))
+                response.try_write(echoed.data(), message_size);
+            else
+                std::this_thread::yield();
+        }
+    });
+    const ScopedPin pin(0);
+
+    std::int64_t messages = 0;
+    for (auto _ : state)
+    {
+        request.try_write(message.data(), message_size);
+        while (!response.try_read(message.data(), message_size))
+            std::this_thread::yield();
+        ++messages;
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    echo.join();
+
+    set_counters(state, messages, message_size);
+}
+
+BENCHMARK_TEMPLATE(fill_drain, nb::RingByteBuffer<>)->RangeMultiplier(4)->Range(16, 1024)->Arg(1400);
+BENCHMARK_TEMPLATE(fill_drain, MutexDequeByteQueue)->RangeMultiplier(4)->Range(16, 1024)->Arg(1400);
+
+BENCHMARK_TEMPLATE(wrap_heavy, nb::RingByteBuffer<>)->Arg(16)->Arg(256)->Arg(1400);
+BENCHMARK_TEMPLATE(wrap_heavy, MutexDequeByteQueue)->Arg(16)->Arg(256)->Arg(1400);
+
+BENCHMARK_TEMPLATE(producer_consumer, nb::SpscRingByteBuffer<>)->Arg(16)->Arg(256)->Arg(1400)->UseRealTime();
+BENCHMARK_TEMPLATE(producer_consumer, MutexDequeByteQueue)->Arg(16)->Arg(256)->Arg(1400)->UseRealTime();
+
+BENCHMARK_TEMPLATE(round_trip, nb::SpscRingByteBuffer<>)->Arg(16)->Arg(1400)->UseRealTime();
+BENCHMARK_TEMPLATE(round_trip, MutexDequeByteQueue)->Arg(16)->Arg(1400)->UseRealTime();
+
+BENCHMARK_MAIN();
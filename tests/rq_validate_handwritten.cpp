@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <cstdlib>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <numeric>
 #include <source_location>
 
 #define TEST_ASSERT(condition) \
@@ -144,6 +146,43 @@ int main()
     TEST_ASSERT(!q3.full());
     TEST_ASSERT(0 == q3.size());
     TEST_ASSERT(4 == q3.capacity());
+    // iterators & indexing on wrapped queues (4, 8 & 1024 use bit mask, 7 uses comparison)
+    for (const int capacity : {4, 7, 8, 1024})
+    {
+        nb::RingQueue<int> q4(capacity);
+        for (int i = 0; i < capacity; ++i)
+            TEST_ASSERT(q4.try_push(-1));
+        for (int i = 0; i < capacity - 1; ++i)
+            q4.pop();
+        q4.pop();
+        TEST_ASSERT(q4.empty());
+        TEST_ASSERT(q4.begin() == q4.end());
+        for (int i = 0; i < capacity; ++i)
+            TEST_ASSERT(q4.try_push(i * 10));
+        TEST_ASSERT(q4.full());
+        TEST_ASSERT(!q4.try_push(-1));
+        TEST_ASSERT(capacity == q4.end() - q4.begin());
+        TEST_ASSERT(capacity == std::distance(q4.cbegin(), q4.cend()));
+        for (int i = 0; i < capacity; ++i)
+        {
+            TEST_ASSERT(i * 10 == q4[i]);
+            TEST_ASSERT(i * 10 == q4.begin()[i]);
+            TEST_ASSERT(i * 10 == *(q4.cbegin() + i));
+        }
+        TEST_ASSERT(q4.back() == *q4.rbegin());
+        TEST_ASSERT(q4.front() == *(q4.rend() - 1));
+        TEST_ASSERT(std::is_sorted(q4.begin(), q4.end()));
+        auto found = std::lower_bound(q4.cbegin(), q4.cend(), 25);
+        TEST_ASSERT(found - q4.cbegin() == 3);
+        TEST_ASSERT(30 == *found);
+        std::for_each(q4.begin(), q4.end(), [](int& elem) { ++elem; });
+        TEST_ASSERT(1 == q4.front());
+        TEST_ASSERT((capacity - 1) * 10 + 1 == q4.back());
+        TEST_ASSERT(std::accumulate(q4.begin(), q4.end(), 0) == capacity * (capacity - 1) * 5 + capacity);
+        q4.pop();
+        TEST_ASSERT(11 == q4[0]);
+        TEST_ASSERT(capacity - 1 == q4.cend() - q4.cbegin());
+    }
 
     std::cout << "All is well!\n";
 }
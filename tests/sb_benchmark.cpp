@@ -56,5 +56,10 @@ void sb_read_after_write(benchmark::State& state, Args&&... args)
 BENCHMARK_TEMPLATE1(sb_read_after_write, sf::Packet)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE1_CAPTURE(sb_read_after_write, nb::SerializeBuffer<>, nb_serialize_buffer_rw, BUF_SIZE)
     ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE1_CAPTURE(sb_read_after_write, nb::SmallSerializeBuffer<BUF_SIZE>, nb_small_serialize_buffer_rw,
+                            BUF_SIZE)
+    ->Unit(benchmark::kMicrosecond);
+
+#include "test_messages_benchmark.inc"
 
 BENCHMARK_MAIN();
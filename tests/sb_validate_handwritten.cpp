@@ -3,6 +3,9 @@
 #include <cstdint>
 #include <iostream>
 #include <source_location>
+#include <span>
+#include <string>
+#include <string_view>
 
 #define TEST_ASSERT(condition) \
     do \
@@ -55,5 +58,141 @@ int main()
     TEST_ASSERT(0 == buf.capacity());
     TEST_ASSERT(1 == buf2.capacity());
 
+    // inline storage
+    nb::SmallSerializeBuffer<4> small;
+    TEST_ASSERT(small.is_inline());
+    TEST_ASSERT(4 == small.capacity());
+    TEST_ASSERT(small << data_16 << data_16);
+    TEST_ASSERT(small.full());
+    TEST_ASSERT(!(small << data_8));
+    small.clear();
+    TEST_ASSERT(small << data_8 << data_16);
+    TEST_ASSERT(small.try_resize(8)); // spills to the allocator
+    TEST_ASSERT(!small.is_inline());
+    TEST_ASSERT(8 == small.capacity());
+    TEST_ASSERT(small << data_16);
+    TEST_ASSERT(small >> data_8);
+    TEST_ASSERT(8 == data_8);
+    small.shrink_to_fit(); // back to the inline storage
+    TEST_ASSERT(small.is_inline());
+    TEST_ASSERT(4 == small.capacity());
+    TEST_ASSERT(4 == small.used_space());
+
+    nb::SmallSerializeBuffer<4> small2(16);
+    TEST_ASSERT(!small2.is_inline());
+    TEST_ASSERT(small2 << data_8);
+    small2.swap(small);
+    TEST_ASSERT(small2.is_inline());
+    TEST_ASSERT(!small.is_inline());
+    TEST_ASSERT(1 == small.used_space());
+    TEST_ASSERT(small >> data_8);
+    TEST_ASSERT(8 == data_8);
+    TEST_ASSERT(small2 >> data_16);
+    TEST_ASSERT(16 == data_16);
+    nb::SmallSerializeBuffer<4> small3(std::move(small2));
+    TEST_ASSERT(small3.is_inline());
+    TEST_ASSERT(small2.is_inline());
+    TEST_ASSERT(2 == small3.used_space());
+    TEST_ASSERT(small3 >> data_16);
+    TEST_ASSERT(16 == data_16);
+    TEST_ASSERT(small3.empty());
+
+    // string peek honours the length type, same as read
+    nb::SerializeBuffer<> peek_buf(16);
+    const std::string peek_str = "peek";
+    TEST_ASSERT((peek_buf.try_write<std::string, std::uint8_t>(peek_str)));
+    std::string peeked;
+    TEST_ASSERT((peek_buf.try_peek<std::string, std::uint8_t>(peeked)));
+    TEST_ASSERT(peek_str == peeked);
+    char peeked_c_str[8];
+    TEST_ASSERT((peek_buf.try_peek<char, std::uint8_t>(peeked_c_str)));
+    TEST_ASSERT(peek_str == peeked_c_str);
+    TEST_ASSERT(1 + peek_str.size() == peek_buf.used_space());
+    TEST_ASSERT(!peek_buf.fail());
+
+    // varint
+    nb::SerializeBuffer<> varint_buf(64);
+    const std::uint64_t varint_u64 = 0xffff'ffff'ffff'ffff;
+    TEST_ASSERT(varint_buf.try_write_varint(std::uint32_t(0)));
+    TEST_ASSERT(varint_buf.try_write_varint(std::uint32_t(300)));
+    TEST_ASSERT(varint_buf.try_write_varint(varint_u64));
+    TEST_ASSERT(1 + 2 + 10 == varint_buf.used_space());
+    std::uint32_t varint_u32_out;
+    std::uint64_t varint_u64_out;
+    TEST_ASSERT(varint_buf.try_read_varint(varint_u32_out));
+    TEST_ASSERT(0 == varint_u32_out);
+    TEST_ASSERT(varint_buf.try_read_varint(varint_u32_out));
+    TEST_ASSERT(300 == varint_u32_out);
+    TEST_ASSERT(varint_buf.try_read_varint(varint_u64_out));
+    TEST_ASSERT(varint_u64 == varint_u64_out);
+    TEST_ASSERT(varint_buf.empty());
+    TEST_ASSERT(!varint_buf.try_read_varint(varint_u32_out));
+    varint_buf.clear();
+    TEST_ASSERT(varint_buf.try_write_varint(varint_u64));
+    TEST_ASSERT(!varint_buf.try_read_varint(varint_u32_out)); // overflow
+    TEST_ASSERT(10 == varint_buf.used_space());
+    varint_buf.clear();
+
+    // reserve & patch
+    nb::SerializeSlot<std::uint16_t> slot;
+    nb::SerializeVarintSlot<std::uint32_t> varint_slot;
+    nb::SerializeSlot<std::uint8_t> small_slot;
+    TEST_ASSERT(varint_buf.try_reserve(slot));
+    TEST_ASSERT(varint_buf << std::uint32_t(7));
+    TEST_ASSERT(varint_buf.try_reserve_varint(varint_slot));
+    TEST_ASSERT(varint_buf << std::string("nested"));
+    TEST_ASSERT(varint_buf.try_patch_length(varint_slot));
+    TEST_ASSERT(varint_buf.try_patch_length(slot));
+    TEST_ASSERT(varint_buf.try_reserve(small_slot));
+    varint_buf.patch(small_slot, std::uint8_t(42));
+
+    std::uint16_t slot_out;
+    std::uint32_t u32_out;
+    std::string str_out;
+    std::uint8_t small_slot_out;
+    TEST_ASSERT(varint_buf >> slot_out);
+    TEST_ASSERT(4 + 5 + 4 + 6 == slot_out);
+    TEST_ASSERT(varint_buf >> u32_out);
+    TEST_ASSERT(7 == u32_out);
+    TEST_ASSERT(varint_buf.try_read_varint(u32_out));
+    TEST_ASSERT(4 + 6 == u32_out);
+    TEST_ASSERT(varint_buf >> str_out);
+    TEST_ASSERT("nested" == str_out);
+    TEST_ASSERT(varint_buf >> small_slot_out);
+    TEST_ASSERT(42 == small_slot_out);
+    TEST_ASSERT(varint_buf.empty());
+    TEST_ASSERT(varint_buf);
+
+    nb::SerializeBuffer<> long_buf(512);
+    TEST_ASSERT(long_buf.try_reserve(small_slot));
+    long_buf.move_write_pos(256);
+    TEST_ASSERT(!long_buf.try_patch_length(small_slot)); // length overflow
+    TEST_ASSERT(long_buf.fail());
+
+    // bounded string reads
+    nb::SerializeBuffer<> str_buf(64);
+    TEST_ASSERT(str_buf << std::string("hello"));
+    TEST_ASSERT(!str_buf.try_read(str_out, 4)); // longer than max length
+    TEST_ASSERT(str_buf.fail());
+    TEST_ASSERT(9 == str_buf.used_space()); // nothing consumed
+    str_buf.clear();
+
+    char c_str_out[6];
+    TEST_ASSERT(str_buf << std::string("hello") << std::string("world!"));
+    TEST_ASSERT(str_buf.try_read(std::span<char>(c_str_out)));
+    TEST_ASSERT(std::string_view("hello") == c_str_out);
+    TEST_ASSERT(!str_buf.try_read(std::span(c_str_out))); // no room for the null terminator
+    TEST_ASSERT(str_buf.fail());
+    TEST_ASSERT(str_buf.try_read(str_out, 6));
+    TEST_ASSERT("world!" == str_out);
+    str_buf.clear();
+
+    // `length * sizeof(char32_t)` wraps around to 4 bytes
+    std::u32string u32_str_out;
+    TEST_ASSERT(str_buf << std::uint64_t(0x4000'0000'0000'0001) << std::uint32_t(0));
+    TEST_ASSERT(!(str_buf.try_read<std::u32string, std::uint64_t>(u32_str_out)));
+    TEST_ASSERT(str_buf.fail());
+    TEST_ASSERT(u32_str_out.empty());
+
     std::cout << "All is well!" << std::endl;
 }
@@ -0,0 +1,109 @@
+#include "NetBuff/SerializeBufferPool.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <source_location>
+#include <type_traits>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed: " << #condition << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::exit(1); \
+        } \
+    } while (false)
+
+using Pool = nb::SerializeBufferPool<>;
+
+template <typename Buf>
+concept Releasable = requires(Pool& pool, Buf& buf) { pool.release(buf); };
+
+// only the buffers acquired from a pool can be released to it
+static_assert(Releasable<Pool::PooledBuffer>);
+static_assert(!Releasable<Pool::Buffer>);
+static_assert(!std::is_constructible_v<Pool::PooledBuffer, const Pool*, std::size_t, std::size_t>);
+
+int main()
+{
+    std::uint32_t data_32 = 32;
+
+    static_assert(Pool::size_class_of(0) == 0);
+    static_assert(Pool::size_class_of(256) == 0);
+    static_assert(Pool::size_class_of(257) == 1);
+    static_assert(Pool::size_class_of(4096) == 2);
+    static_assert(Pool::size_class_of(64 * 1024) == 3);
+    static_assert(Pool::size_class_of(64 * 1024 + 1) == Pool::OVERSIZED);
+
+    Pool pool;
+
+    // first acquire is a miss
+    auto& buf1 = pool.acquire(100);
+    TEST_ASSERT(256 == buf1.capacity());
+    TEST_ASSERT(buf1.empty());
+    TEST_ASSERT(1 == pool.stats(0).misses);
+    TEST_ASSERT(0 == pool.stats(0).hits);
+    TEST_ASSERT(1 == pool.used_count());
+    TEST_ASSERT(buf1 << data_32);
+    const std::byte* const buf1_data = buf1.data();
+    pool.release(buf1);
+    TEST_ASSERT(1 == pool.cached_count(0));
+    TEST_ASSERT(0 == pool.used_count());
+
+    // same size class reuses the cleared buffer
+    auto& buf2 = pool.acquire(200);
+    TEST_ASSERT(&buf1 == &buf2);
+    TEST_ASSERT(buf1_data == buf2.data());
+    TEST_ASSERT(buf2.empty());
+    TEST_ASSERT(1 == pool.stats(0).hits);
+    TEST_ASSERT(0 == pool.cached_count(0));
+
+    // another size class doesn't
+    auto& buf3 = pool.acquire(1000);
+    TEST_ASSERT(1024 == buf3.capacity());
+    TEST_ASSERT(&buf2 != &buf3);
+    TEST_ASSERT(1 == pool.stats(1).misses);
+
+    // shrinked buffer is restored to its size class capacity
+    buf3.shrink_to_fit();
+    TEST_ASSERT(0 == buf3.capacity());
+    pool.release(buf3);
+    auto& buf4 = pool.acquire(1024);
+    TEST_ASSERT(1024 == buf4.capacity());
+    TEST_ASSERT(1 == pool.stats(1).hits);
+
+    // oversized buffer is never cached
+    auto& big = pool.acquire(100 * 1024);
+    TEST_ASSERT(100 * 1024 == big.capacity());
+    TEST_ASSERT(1 == pool.stats(Pool::OVERSIZED).misses);
+    pool.release(big);
+    auto& big2 = pool.acquire(100 * 1024);
+    TEST_ASSERT(2 == pool.stats(Pool::OVERSIZED).misses);
+    TEST_ASSERT(0 == pool.stats(Pool::OVERSIZED).hits);
+    pool.release(big2);
+
+    pool.release(buf2);
+    pool.release(buf4);
+    TEST_ASSERT(0 == pool.used_count());
+
+    const auto total = pool.total_stats();
+    TEST_ASSERT(2 == total.hits);
+    TEST_ASSERT(4 == total.misses);
+
+    // grown buffer is shrinked back to its size class capacity on release
+    auto& buf7 = pool.acquire(100);
+    TEST_ASSERT(buf7.try_resize(1024 * 1024));
+    TEST_ASSERT(1024 * 1024 == buf7.capacity());
+    pool.release(buf7);
+    auto& buf8 = pool.acquire(100);
+    TEST_ASSERT(&buf7 == &buf8);
+    TEST_ASSERT(256 == buf8.capacity());
+    TEST_ASSERT(4 == pool.total_stats().hits);
+    pool.release(buf8);
+
+    std::cout << "All is well!" << std::endl;
+}
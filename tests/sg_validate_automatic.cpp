@@ -0,0 +1,257 @@
+#include "test_messages.hpp"
+
+#include "NetBuff/ChainedBuffer.hpp"
+#include "NetBuff/SerializeBuffer.hpp"
+#include "NetBuff/SerializeReader.hpp"
+#include "NetBuff/SerializeWriter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <source_location>
+#include <string>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed " << #condition << " at phase #" << phase << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+namespace nb_test::schema
+{
+
+bool operator==(const Vec3& lhs, const Vec3& rhs)
+{
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+}
+
+bool operator==(const Move& lhs, const Move& rhs)
+{
+    return lhs.entity_id == rhs.entity_id && lhs.pos == rhs.pos && lhs.velocity == rhs.velocity &&
+           lhs.inputs == rhs.inputs && lhs.running == rhs.running;
+}
+
+bool operator==(const Chat& lhs, const Chat& rhs)
+{
+    return lhs.sender_id == rhs.sender_id && lhs.channel == rhs.channel && lhs.sender == rhs.sender &&
+           lhs.text == rhs.text;
+}
+
+bool operator==(const Inventory& lhs, const Inventory& rhs)
+{
+    return lhs.owner_id == rhs.owner_id && lhs.item_ids == rhs.item_ids && lhs.counts == rhs.counts &&
+           lhs.tags == rhs.tags && lhs.drop_points == rhs.drop_points && lhs.weight == rhs.weight &&
+           lhs.flags == rhs.flags && lhs.slot == rhs.slot && lhs.gold == rhs.gold;
+}
+
+} // namespace nb_test::schema
+
+namespace
+{
+
+using namespace nb_test::schema;
+
+constexpr std::size_t BUF_SIZE = 4096;
+constexpr std::size_t MAX_ELEMENTS = 16;
+
+constexpr int PHASES = 10000;
+
+static_assert(Vec3::FIXED_SIZE == 12 && Vec3::MIN_SIZE == 12);
+static_assert(Move::FIXED_SIZE == 33 && Move::MIN_SIZE == 33);
+static_assert(Chat::FIXED_SIZE == 9 && Chat::MIN_SIZE == 17);
+
+class RandomFiller
+{
+public:
+    explicit RandomFiller(std::mt19937& rng) : _rng(rng)
+    {
+    }
+
+    template <typename Num>
+    auto num() -> Num
+    {
+        if constexpr (std::is_floating_point_v<Num>)
+            return std::uniform_real_distribution<Num>(-1000, 1000)(_rng);
+        else if constexpr (std::is_same_v<Num, bool>)
+            return _rng() % 2;
+        else
+            return static_cast<Num>(std::uniform_int_distribution<std::uint64_t>()(_rng));
+    }
+
+    auto count() -> std::size_t
+    {
+        return std::uniform_int_distribution<std::size_t>(0, MAX_ELEMENTS)(_rng);
+    }
+
+    auto str() -> std::string
+    {
+        std::string result(count() * 2, '\0');
+        for (char& ch : result)
+            ch = static_cast<char>('a' + _rng() % 26);
+        return result;
+    }
+
+    auto vec3() -> Vec3
+    {
+        return {num<float>(), num<float>(), num<float>()};
+    }
+
+    auto move() -> Move
+    {
+        Move msg;
+        msg.entity_id = num<std::uint32_t>();
+        msg.pos = vec3();
+        msg.velocity = vec3();
+        for (auto& input : msg.inputs)
+            input = num<std::uint8_t>();
+        msg.running = num<bool>();
+        return msg;
+    }
+
+    auto chat() -> Chat
+    {
+        return {num<std::uint64_t>(), num<std::uint8_t>(), str(), str()};
+    }
+
+    auto inventory() -> Inventory
+    {
+        Inventory msg;
+        msg.owner_id = num<std::uint32_t>();
+        msg.item_ids.resize(count());
+        for (auto& id : msg.item_ids)
+            id = num<std::uint16_t>();
+        msg.counts.resize(count());
+        for (auto& cnt : msg.counts)
+            cnt = num<std::int32_t>();
+        msg.tags.resize(count());
+        for (auto& tag : msg.tags)
+            tag = str();
+        msg.drop_points.resize(count());
+        for (auto& point : msg.drop_points)
+            point = vec3();
+        msg.weight = num<double>();
+        for (auto& flag : msg.flags)
+            flag = num<std::int8_t>();
+        msg.slot = num<std::int16_t>();
+        msg.gold = num<std::int64_t>();
+        return msg;
+    }
+
+private:
+    std::mt19937& _rng;
+};
+
+template <typename Msg>
+void validate_message(int phase, const Msg& msg)
+{
+    // round trip via `SerializeBuffer`
+    nb::SerializeBuffer<> buf(BUF_SIZE);
+    TEST_ASSERT(msg.try_encode(buf));
+    TEST_ASSERT(msg.encoded_size() == buf.used_space());
+    TEST_ASSERT(Msg::MIN_SIZE <= buf.used_space());
+
+    Msg decoded;
+    TEST_ASSERT(decoded.try_decode(buf));
+    TEST_ASSERT(buf.empty());
+    TEST_ASSERT(msg == decoded);
+
+    // encode to `SerializeWriter`, and decode from `SerializeReader`
+    std::vector<std::byte> storage(msg.encoded_size());
+    nb::SerializeWriter writer(storage);
+    TEST_ASSERT(msg.try_encode(writer));
+    TEST_ASSERT(writer.full());
+    TEST_ASSERT(0 == std::memcmp(storage.data(), buf.data(), storage.size()));
+
+    nb::SerializeReader reader(storage);
+    Msg decoded_2;
+    TEST_ASSERT(decoded_2.try_decode(reader));
+    TEST_ASSERT(reader.empty());
+    TEST_ASSERT(msg == decoded_2);
+
+    // encode fails without enough space
+    nb::SerializeBuffer<> small_buf(msg.encoded_size() - 1);
+    TEST_ASSERT(!msg.try_encode(small_buf));
+    TEST_ASSERT(small_buf.fail());
+
+    // decode fails on the truncated message
+    nb::SerializeReader truncated(std::span<const std::byte>(storage).first(storage.size() - 1));
+    TEST_ASSERT(!decoded_2.try_decode(truncated));
+    TEST_ASSERT(truncated.fail());
+}
+
+void validate(std::mt19937& rng)
+{
+    RandomFiller filler(rng);
+
+    for (int phase = 1; phase <= PHASES; ++phase)
+    {
+        validate_message(phase, filler.vec3());
+        validate_message(phase, filler.move());
+        validate_message(phase, filler.chat());
+        validate_message(phase, filler.inventory());
+    }
+
+    // huge count from a malformed message doesn't allocate
+    {
+        constexpr int phase = PHASES + 1;
+
+        nb::SerializeBuffer<> buf(64);
+        TEST_ASSERT(buf << std::uint32_t(0) << std::uint32_t(0xFFFF'FFFF));
+        Inventory inventory;
+        TEST_ASSERT(!inventory.try_decode(buf));
+        TEST_ASSERT(buf.fail());
+        TEST_ASSERT(inventory.item_ids.empty());
+    }
+
+    // fail bit is set even on a buffer without a bounded capacity
+    {
+        constexpr int phase = PHASES + 2;
+
+        nb::ChainedBuffer<64>::SegmentPool pool;
+        nb::ChainedBuffer<64> buf(pool);
+        if constexpr (sizeof(std::size_t) > sizeof(nb::SchemaCodec::CountType))
+        {
+            const std::size_t too_many = std::size_t(std::numeric_limits<nb::SchemaCodec::CountType>::max()) + 1;
+            TEST_ASSERT(!nb::SchemaCodec::try_write_count(buf, too_many));
+            TEST_ASSERT(buf.fail());
+            TEST_ASSERT(buf.empty());
+            buf.clear();
+        }
+
+        TEST_ASSERT(buf << std::uint32_t(0) << std::uint32_t(0xFFFF'FFFF));
+        Inventory inventory;
+        TEST_ASSERT(!inventory.try_decode(buf));
+        TEST_ASSERT(buf.fail());
+        TEST_ASSERT(inventory.item_ids.empty());
+        buf.clear();
+    }
+}
+
+} // namespace
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    std::mt19937 rng(seed);
+
+    validate(rng);
+
+    std::cout << "All is well!" << std::endl;
+}
@@ -0,0 +1,116 @@
+#include "NetBuff/SharedPayload.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <source_location>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed: " << #condition << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::exit(1); \
+        } \
+    } while (false)
+
+static constexpr std::string_view HELLO = "hello";
+static constexpr std::string_view WORLD = "world!";
+
+nb::SharedPayload<> make_payload(std::string_view str)
+{
+    nb::SerializeBuffer<> buf(str.size());
+    buf.try_write(str.data(), str.size());
+    return nb::SharedPayload<>(std::move(buf));
+}
+
+std::string_view to_string_view(std::span<const std::byte> bytes)
+{
+    return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+int main()
+{
+    // empty payload
+    nb::SharedPayload<> empty;
+    TEST_ASSERT(!empty);
+    TEST_ASSERT(0 == empty.size());
+    TEST_ASSERT(0 == empty.use_count());
+
+    // frozen buffer shares its unread data
+    nb::SerializeBuffer<> buf(16);
+    std::uint8_t data_8 = 8;
+    buf << data_8;
+    buf.try_write(HELLO.data(), HELLO.size());
+    buf >> data_8;
+    nb::SharedPayload<> hello(std::move(buf));
+    TEST_ASSERT(hello);
+    TEST_ASSERT(0 == buf.capacity());
+    TEST_ASSERT(HELLO == to_string_view(hello.bytes()));
+    TEST_ASSERT(1 == hello.use_count());
+
+    // copies share the same data
+    {
+        std::vector<nb::SharedPayload<>> copies(100, hello);
+        TEST_ASSERT(101 == hello.use_count());
+        TEST_ASSERT(copies.back().data() == hello.data());
+    }
+    TEST_ASSERT(1 == hello.use_count());
+
+    nb::SharedPayload<> moved(std::move(hello));
+    TEST_ASSERT(!hello);
+    TEST_ASSERT(1 == moved.use_count());
+    hello = moved;
+    TEST_ASSERT(2 == moved.use_count());
+    moved.reset();
+    TEST_ASSERT(1 == hello.use_count());
+
+    // send queue
+    nb::SharedPayloadQueue<> queue(2);
+    const auto world = make_payload(WORLD);
+    TEST_ASSERT(queue.try_push(hello));
+    TEST_ASSERT(queue.try_push(world));
+    TEST_ASSERT(!queue.try_push(world));
+    TEST_ASSERT(2 == hello.use_count());
+    TEST_ASSERT(2 == world.use_count());
+    TEST_ASSERT(HELLO.size() + WORLD.size() == queue.pending_bytes());
+
+    std::array<std::span<const std::byte>, 4> segments;
+    TEST_ASSERT(2 == queue.gather(segments));
+    TEST_ASSERT(HELLO == to_string_view(segments[0]));
+    TEST_ASSERT(WORLD == to_string_view(segments[1]));
+    TEST_ASSERT(1 == queue.gather(std::span(segments).first(1)));
+
+    // partial send
+    queue.consume(3);
+    TEST_ASSERT(2 == queue.size());
+    TEST_ASSERT(2 == queue.gather(segments));
+    TEST_ASSERT("lo" == to_string_view(segments[0]));
+    queue.consume(4);
+    TEST_ASSERT(1 == queue.size());
+    TEST_ASSERT(1 == hello.use_count());
+    TEST_ASSERT(1 == queue.gather(segments));
+    TEST_ASSERT("rld!" == to_string_view(segments[0]));
+    TEST_ASSERT(queue.try_push(make_payload(HELLO)));
+    queue.consume(4 + HELLO.size());
+    TEST_ASSERT(queue.empty());
+    TEST_ASSERT(0 == queue.pending_bytes());
+    TEST_ASSERT(1 == world.use_count());
+    TEST_ASSERT(0 == queue.gather(segments));
+
+    TEST_ASSERT(queue.try_push(world));
+    queue.clear();
+    TEST_ASSERT(queue.empty());
+    TEST_ASSERT(1 == world.use_count());
+
+    std::cout << "All is well!" << std::endl;
+}
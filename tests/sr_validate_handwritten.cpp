@@ -0,0 +1,155 @@
+#include "NetBuff/SerializeBuffer.hpp"
+#include "NetBuff/SerializeReader.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <source_location>
+#include <string>
+#include <thread>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed: " << #condition << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::exit(1); \
+        } \
+    } while (false)
+
+// a reader only has the read operations
+template <typename Stream>
+concept ReadsNum = requires(Stream& stream, std::uint32_t num) { stream.try_read(num); };
+
+template <typename Stream>
+concept PeeksNum = requires(Stream& stream, std::uint32_t num) { stream.try_peek(num); };
+
+template <typename Stream>
+concept ReadsString = requires(Stream& stream, std::string str) { stream >> str; };
+
+template <typename Stream>
+concept ReadsVarint = requires(Stream& stream, std::uint32_t num) { stream.try_read_varint(num); };
+
+template <typename Stream>
+concept WritesNum = requires(Stream& stream, std::uint32_t num) { stream.try_write(num); };
+
+template <typename Stream>
+concept WritesString = requires(Stream& stream, std::string str) { stream << str; };
+
+template <typename Stream>
+concept WritesVarint = requires(Stream& stream, std::uint32_t num) { stream.try_write_varint(num); };
+
+static_assert(ReadsNum<nb::SerializeReader> && PeeksNum<nb::SerializeReader> && ReadsString<nb::SerializeReader> &&
+              ReadsVarint<nb::SerializeReader>);
+static_assert(!WritesNum<nb::SerializeReader> && !WritesString<nb::SerializeReader> &&
+              !WritesVarint<nb::SerializeReader>);
+
+int main()
+{
+    const std::uint16_t u16 = 0x1234;
+    const std::uint64_t u64 = 0x0123'4567'89ab'cdef;
+    const float f = 1.5f;
+    const std::string str = "The quick brown fox jumps over the lazy dog!";
+    const wchar_t* c_wstr = L"Hello, world!";
+
+    std::uint16_t u16_out;
+    std::uint64_t u64_out;
+    float f_out;
+    std::string str_out;
+    wchar_t c_wstr_out[16];
+
+    nb::SerializeBuffer<> buf(128);
+    TEST_ASSERT(buf << u16 << u64 << f << str << c_wstr);
+    const std::size_t message_size = buf.used_space();
+
+    // read from a span
+    nb::SerializeReader reader({buf.data(), buf.used_space()});
+    TEST_ASSERT(message_size == reader.used_space());
+    TEST_ASSERT(reader.try_peek(u16_out));
+    TEST_ASSERT(u16 == u16_out);
+    TEST_ASSERT(reader >> u16_out >> u64_out >> f_out >> str_out >> c_wstr_out);
+    TEST_ASSERT(u16 == u16_out);
+    TEST_ASSERT(u64 == u64_out);
+    TEST_ASSERT(f == f_out);
+    TEST_ASSERT(str == str_out);
+    TEST_ASSERT(std::wstring(c_wstr) == c_wstr_out);
+    TEST_ASSERT(reader.empty());
+    TEST_ASSERT(message_size == reader.read_bytes());
+    TEST_ASSERT(!(reader >> u16_out));
+    TEST_ASSERT(reader.fail());
+
+    // read from a wrapped ring, at every wrap position
+    for (std::size_t offset = 0; offset <= message_size; ++offset)
+    {
+        nb::RingByteBuffer<> ring(message_size);
+        ring.move_read_pos(offset);
+        ring.move_write_pos(offset);
+        TEST_ASSERT(ring.try_write(buf.data(), message_size));
+
+        nb::SerializeReader ring_reader(ring);
+        TEST_ASSERT(message_size == ring_reader.used_space());
+        str_out.clear();
+        TEST_ASSERT(ring_reader >> u16_out >> u64_out >> f_out >> str_out >> c_wstr_out);
+        TEST_ASSERT(u16 == u16_out);
+        TEST_ASSERT(u64 == u64_out);
+        TEST_ASSERT(f == f_out);
+        TEST_ASSERT(str == str_out);
+        TEST_ASSERT(std::wstring(c_wstr) == c_wstr_out);
+        TEST_ASSERT(ring_reader.empty());
+
+        ring.move_read_pos(ring_reader.read_bytes());
+        TEST_ASSERT(ring.empty());
+    }
+
+    // read from a spsc ring (consumer side)
+    nb::SpscRingByteBuffer<> spsc_ring(message_size);
+    spsc_ring.move_read_pos(5);
+    spsc_ring.move_write_pos(5);
+    TEST_ASSERT(spsc_ring.try_write(buf.data(), message_size));
+    nb::SerializeReader spsc_reader(spsc_ring);
+    TEST_ASSERT(spsc_reader >> u16_out >> u64_out);
+    TEST_ASSERT(u16 == u16_out);
+    TEST_ASSERT(u64 == u64_out);
+
+    // read from a spsc ring, while the producer keeps writing & wrapping around
+    {
+        constexpr std::uint32_t COUNT = 200000;
+        nb::SpscRingByteBuffer<> concurrent_ring(61); // not a multiple of 4, so values straddle the end
+
+        std::thread producer([&concurrent_ring] {
+            for (std::uint32_t value = 0; value < COUNT;)
+            {
+                if (concurrent_ring.try_write(&value, sizeof(value)))
+                    ++value;
+                else
+                    std::this_thread::yield();
+            }
+        });
+
+        for (std::uint32_t expected = 0; expected < COUNT;)
+        {
+            nb::SerializeReader concurrent_reader(concurrent_ring);
+            TEST_ASSERT(concurrent_reader.used_space() <= concurrent_ring.effective_capacity());
+
+            std::uint32_t value;
+            while (concurrent_reader.used_space() >= sizeof(value))
+            {
+                TEST_ASSERT(concurrent_reader >> value);
+                TEST_ASSERT(expected == value);
+                ++expected;
+            }
+
+            concurrent_ring.move_read_pos(static_cast<std::ptrdiff_t>(concurrent_reader.read_bytes()));
+            if (concurrent_reader.read_bytes() == 0)
+                std::this_thread::yield();
+        }
+
+        producer.join();
+        TEST_ASSERT(concurrent_ring.available_read() == 0);
+    }
+
+    std::cout << "All is well!" << std::endl;
+}
@@ -0,0 +1,109 @@
+#include "NetBuff/SerializeBuffer.hpp"
+#include "NetBuff/SerializeWriter.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <source_location>
+#include <string>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed: " << #condition << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::exit(1); \
+        } \
+    } while (false)
+
+// a writer only has the write operations
+template <typename Stream>
+concept WritesNum = requires(Stream& stream, std::uint32_t num) { stream.try_write(num); };
+
+template <typename Stream>
+concept WritesString = requires(Stream& stream, std::string str) { stream << str; };
+
+template <typename Stream>
+concept WritesVarint = requires(Stream& stream, std::uint32_t num) { stream.try_write_varint(num); };
+
+template <typename Stream>
+concept ReadsNum = requires(Stream& stream, std::uint32_t num) { stream.try_read(num); };
+
+template <typename Stream>
+concept PeeksNum = requires(Stream& stream, std::uint32_t num) { stream.try_peek(num); };
+
+template <typename Stream>
+concept ReadsString = requires(Stream& stream, std::string str) { stream >> str; };
+
+template <typename Stream>
+concept ReadsVarint = requires(Stream& stream, std::uint32_t num) { stream.try_read_varint(num); };
+
+static_assert(WritesNum<nb::SerializeWriter> && WritesString<nb::SerializeWriter> && WritesVarint<nb::SerializeWriter>);
+static_assert(!ReadsNum<nb::SerializeWriter> && !PeeksNum<nb::SerializeWriter> && !ReadsString<nb::SerializeWriter> &&
+              !ReadsVarint<nb::SerializeWriter>);
+
+int main()
+{
+    const std::uint16_t u16 = 0x1234;
+    const std::uint64_t u64 = 0x0123'4567'89ab'cdef;
+    const double d = -2.25;
+    const std::string str = "The quick brown fox jumps over the lazy dog!";
+    const char16_t* c_u16str = u"Hello, world!";
+
+    // reference encoding
+    nb::SerializeBuffer<> buf(128);
+    TEST_ASSERT(buf << u16 << u64 << d << str << c_u16str);
+    const std::size_t message_size = buf.used_space();
+
+    // write to a span
+    std::array<std::byte, 128> storage;
+    nb::SerializeWriter writer(storage);
+    TEST_ASSERT(writer << u16 << u64 << d << str << c_u16str);
+    TEST_ASSERT(message_size == writer.written_bytes());
+    TEST_ASSERT(storage.size() - message_size == writer.available_space());
+    TEST_ASSERT(0 == std::memcmp(buf.data(), storage.data(), message_size));
+
+    // write fails on overflow, and leaves the data as is
+    nb::SerializeWriter small_writer(std::span<std::byte>(storage.data(), 9));
+    TEST_ASSERT(small_writer.try_write(u64));
+    TEST_ASSERT(!small_writer.try_write(u16));
+    TEST_ASSERT(!small_writer.try_write(str));
+    TEST_ASSERT(small_writer.fail());
+    TEST_ASSERT(8 == small_writer.written_bytes());
+    small_writer.clear();
+    TEST_ASSERT(!small_writer.fail());
+    TEST_ASSERT(0 == small_writer.written_bytes());
+
+    // write to the consecutive free space of a ring
+    nb::RingByteBuffer<> ring(message_size * 2);
+    ring.move_read_pos(message_size / 2);
+    ring.move_write_pos(message_size / 2);
+    {
+        nb::SerializeWriter ring_writer(ring);
+        TEST_ASSERT(ring.consecutive_write_length() == ring_writer.available_space());
+        TEST_ASSERT(ring_writer << u16 << u64 << d << str << c_u16str);
+        ring.move_write_pos(ring_writer.written_bytes());
+    }
+    TEST_ASSERT(message_size == ring.used_space());
+    std::array<std::byte, 128> ring_out;
+    TEST_ASSERT(ring.try_read(ring_out.data(), message_size));
+    TEST_ASSERT(0 == std::memcmp(buf.data(), ring_out.data(), message_size));
+
+    // write to the consecutive free space of a spsc ring (producer side)
+    nb::SpscRingByteBuffer<> spsc_ring(message_size);
+    {
+        nb::SerializeWriter spsc_writer(spsc_ring);
+        TEST_ASSERT(spsc_writer << u16 << u64 << d << str << c_u16str);
+        TEST_ASSERT(spsc_writer.full());
+        spsc_ring.move_write_pos(spsc_writer.written_bytes());
+    }
+    TEST_ASSERT(spsc_ring.try_read(ring_out.data(), message_size));
+    TEST_ASSERT(0 == std::memcmp(buf.data(), ring_out.data(), message_size));
+
+    std::cout << "All is well!" << std::endl;
+}
@@ -0,0 +1,208 @@
+#include "NetBuff/TimingWheel.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <source_location>
+#include <vector>
+
+#define TEST_ASSERT(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            const auto loc = std::source_location::current(); \
+            std::cout << "Failed " << #condition << " at phase #" << phase << "\n\t"; \
+            std::cout << "at " << loc.file_name() << ":" << loc.line() << ":" << loc.column() << "\n"; \
+            std::cout << std::flush; \
+            std::exit(2); \
+        } \
+    } while (false)
+
+namespace
+{
+
+using tick_type = nb::TimingWheelTimer::tick_type;
+
+constexpr std::size_t TIMERS = 2000;
+
+constexpr int PHASES = 20000;
+
+struct MyTimer : public nb::TimingWheelTimer
+{
+    tick_type fire_at; // tick which this should be expired at
+    bool expired = false;
+};
+
+template <std::size_t SlotBits, std::size_t Levels>
+void validate(std::mt19937& rng, const tick_type max_delay, const tick_type max_step)
+{
+    using Wheel = nb::TimingWheel<MyTimer, SlotBits, Levels>;
+
+    const tick_type start = std::uniform_int_distribution<tick_type>(0, 1'000'000)(rng);
+
+    Wheel wheel(start);
+    std::vector<MyTimer> timers(TIMERS);
+    std::size_t scheduled = 0;
+
+    std::uniform_int_distribution<std::size_t> timer_dist(0, TIMERS - 1);
+    std::uniform_int_distribution<tick_type> delay_dist(0, max_delay);
+    std::uniform_int_distribution<tick_type> step_dist(0, max_step);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    auto expiry_after = [&](tick_type delay) -> tick_type {
+        // sometimes already passed
+        return (percent(rng) < 5) ? wheel.now() - std::min(wheel.now(), delay) : wheel.now() + delay;
+    };
+
+    auto schedule = [&](MyTimer& timer, tick_type expiry) {
+        if (!timer.scheduled())
+            ++scheduled;
+
+        timer.fire_at = std::max(expiry, wheel.now() + 1);
+        timer.expired = false;
+        wheel.reschedule(timer, expiry);
+    };
+
+    for (int phase = 1; phase <= PHASES; ++phase)
+    {
+        // schedule, reschedule or cancel random timers
+        const int ops = std::uniform_int_distribution<int>(0, 20)(rng);
+        for (int op = 0; op < ops; ++op)
+        {
+            MyTimer& timer = timers[timer_dist(rng)];
+            if (percent(rng) < 20)
+            {
+                const bool was_scheduled = timer.scheduled();
+                TEST_ASSERT(was_scheduled == wheel.cancel(timer));
+                TEST_ASSERT(!timer.scheduled());
+                if (was_scheduled)
+                    --scheduled;
+            }
+            else
+            {
+                const tick_type expiry = expiry_after(delay_dist(rng));
+                schedule(timer, expiry);
+                TEST_ASSERT(timer.scheduled());
+                TEST_ASSERT(expiry == timer.expiry());
+            }
+        }
+        TEST_ASSERT(scheduled == wheel.size());
+
+        // advance, while rescheduling & cancelling timers on expiration
+        const tick_type now = wheel.now() + step_dist(rng);
+        std::size_t expired = 0;
+
+        const std::size_t expired_count = wheel.advance(now, [&](MyTimer& timer) {
+            TEST_ASSERT(!timer.scheduled());
+            TEST_ASSERT(timer.fire_at == wheel.now());
+            TEST_ASSERT(!timer.expired);
+            timer.expired = true;
+            --scheduled;
+            ++expired;
+
+            const int action = percent(rng);
+            if (action < 10)
+            {
+                schedule(timer, wheel.now() + delay_dist(rng));
+            }
+            else if (action < 20)
+            {
+                MyTimer& other = timers[timer_dist(rng)];
+                if (wheel.cancel(other))
+                    --scheduled;
+            }
+        });
+
+        TEST_ASSERT(expired == expired_count);
+        TEST_ASSERT(now == wheel.now());
+        TEST_ASSERT(scheduled == wheel.size());
+
+        // every timer due is expired
+        for (const MyTimer& timer : timers)
+        {
+            if (timer.scheduled())
+                TEST_ASSERT(timer.fire_at > now);
+        }
+    }
+
+    // far timers are expired exactly, after being parked at the end of the wheel
+    {
+        constexpr int phase = PHASES + 1;
+
+        for (MyTimer& timer : timers)
+            wheel.cancel(timer);
+        TEST_ASSERT(wheel.empty());
+
+        MyTimer& timer = timers.front();
+        const tick_type expiry = wheel.now() + Wheel::RANGE * 3 + 5;
+        schedule(timer, expiry);
+
+        TEST_ASSERT(0 == wheel.advance(expiry - 1, [](MyTimer&) {}));
+        TEST_ASSERT(1 == wheel.advance(expiry, [&](MyTimer& expired) {
+            TEST_ASSERT(&timer == &expired);
+            TEST_ASSERT(expiry == wheel.now());
+        }));
+        TEST_ASSERT(wheel.empty());
+    }
+
+    // `on_expire` throwing or re-entering leaves the rest of the bucket to the next `advance()`
+    {
+        constexpr int phase = PHASES + 2;
+
+        const tick_type expiry = wheel.now() + 3;
+        for (std::size_t idx = 0; idx < 4; ++idx)
+            schedule(timers[idx], expiry);
+        schedule(timers[4], expiry + 5);
+
+        bool thrown = false;
+        try
+        {
+            wheel.advance(expiry, [](MyTimer&) { throw 0; });
+        }
+        catch (int)
+        {
+            thrown = true;
+        }
+        TEST_ASSERT(thrown);
+        TEST_ASSERT(expiry == wheel.now());
+        TEST_ASSERT(4 == wheel.size());
+
+        std::size_t inner_expired = 0;
+        const std::size_t outer_expired = wheel.advance(expiry + 10, [&](MyTimer& timer) {
+            TEST_ASSERT(expiry == timer.expiry());
+            inner_expired = wheel.advance(expiry + 10, [&](MyTimer&) {});
+        });
+        TEST_ASSERT(1 == outer_expired);
+        TEST_ASSERT(3 == inner_expired);
+        TEST_ASSERT(expiry + 10 == wheel.now());
+        TEST_ASSERT(wheel.empty());
+    }
+}
+
+} // namespace
+
+int main()
+{
+    unsigned seed = []() -> unsigned {
+        std::random_device rd;
+        return rd();
+    }();
+
+    std::cout << "seed=" << seed << "\n";
+
+    std::mt19937 rng(seed);
+
+    // tiny wheel: lots of cascades & timers beyond the range
+    validate<2, 3>(rng, 200, 8);
+    validate<3, 2>(rng, 100, 3);
+    // single level: far timers are parked in the only level
+    validate<2, 1>(rng, 30, 3);
+    validate<4, 1>(rng, 100, 5);
+    // default wheel
+    validate<8, 4>(rng, 100'000, 300);
+
+    std::cout << "All is well!" << std::endl;
+}
@@ -0,0 +1,916 @@
+// nb_schemac: Generates C++ structs with encode & decode functions from a message schema.
+//
+// Usage: nb_schemac <schema> -o <header> [--benchmark <benchmark.inc>]
+//
+// Schema syntax:
+//   // comment
+//   namespace game.net;            (optional, becomes `namespace game::net`)
+//
+//   message Vec3 {
+//       f32 x;
+//       f32 y;
+//       f32 z;
+//   }
+//
+//   message Move {
+//       u32 entity_id;
+//       Vec3 pos;                  (message defined above)
+//       u8[4] inputs;              (fixed-size array, `std::array`)
+//       string name;               (`std::string`, u32 length prefix)
+//       u16[] items;               (variable-size array, `std::vector`, u32 count prefix)
+//   }
+//
+// Types: bool u8 u16 u32 u64 i8 i16 i32 i64 f32 f64 string, and the messages defined above
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+struct ScalarType
+{
+    std::string_view name;
+    std::string_view cpp_name;
+    std::size_t size;
+};
+
+constexpr ScalarType SCALAR_TYPES[] = {
+    {"bool", "bool", 1},         {"u8", "::std::uint8_t", 1},  {"u16", "::std::uint16_t", 2},
+    {"u32", "::std::uint32_t", 4}, {"u64", "::std::uint64_t", 8}, {"i8", "::std::int8_t", 1},
+    {"i16", "::std::int16_t", 2},  {"i32", "::std::int32_t", 4},  {"i64", "::std::int64_t", 8},
+    {"f32", "float", 4},         {"f64", "double", 8},
+};
+
+constexpr std::size_t COUNT_SIZE = 4; // `nb::SchemaCodec::CountType`
+
+// members of the generated structs
+constexpr std::string_view RESERVED_NAMES[] = {
+    "FIXED_SIZE", "MIN_SIZE", "encoded_size", "try_encode", "try_decode", "store_to", "load_from",
+};
+
+// can't be used as namespace, message or field names of the generated code
+constexpr std::string_view CPP_KEYWORDS[] = {
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char",
+    "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const", "consteval", "constexpr", "constinit",
+    "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete", "do", "double",
+    "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if",
+    "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+    "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "requires", "return", "short", "signed",
+    "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local", "throw",
+    "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile",
+    "wchar_t", "while", "xor", "xor_eq",
+};
+
+enum class TypeKind
+{
+    SCALAR,
+    STRING,
+    MESSAGE,
+};
+
+enum class FieldKind
+{
+    SINGLE,
+    FIXED_ARRAY,
+    VECTOR,
+};
+
+struct Message;
+
+struct Field
+{
+    TypeKind type_kind;
+    const ScalarType* scalar = nullptr;
+    const Message* message = nullptr;
+
+    FieldKind kind = FieldKind::SINGLE;
+    std::size_t count = 0; // for `FieldKind::FIXED_ARRAY`
+
+    std::string name;
+
+    /// @brief Fixed-size fields are coalesced with the adjacent ones.
+    bool is_fixed() const;
+
+    auto element_size() const -> std::size_t;
+
+    auto fixed_size() const -> std::size_t
+    {
+        return element_size() * (kind == FieldKind::FIXED_ARRAY ? count : 1);
+    }
+};
+
+struct Message
+{
+    std::string name;
+    std::vector<Field> fields;
+
+    /// @brief Whether every field is fixed-size, so that it can be coalesced with the adjacent fields.
+    bool is_fixed() const
+    {
+        return std::ranges::all_of(fields, [](const Field& field) { return field.is_fixed(); });
+    }
+
+    auto fixed_size() const -> std::size_t
+    {
+        std::size_t size = 0;
+        for (const Field& field : fields)
+            if (field.is_fixed())
+                size += field.fixed_size();
+
+        return size;
+    }
+
+    /// @brief Minimum encoded size. (i.e. All strings & variable-size arrays are empty)
+    auto min_size() const -> std::size_t
+    {
+        std::size_t size = 0;
+        for (const Field& field : fields)
+        {
+            if (field.is_fixed())
+                size += field.fixed_size();
+            else if (field.kind == FieldKind::VECTOR || field.type_kind == TypeKind::STRING)
+                size += COUNT_SIZE * (field.kind == FieldKind::FIXED_ARRAY ? field.count : 1);
+            else
+                size += field.message->min_size() * (field.kind == FieldKind::FIXED_ARRAY ? field.count : 1);
+        }
+
+        return size;
+    }
+};
+
+bool Field::is_fixed() const
+{
+    if (kind == FieldKind::VECTOR)
+        return false;
+
+    return type_kind == TypeKind::SCALAR || (type_kind == TypeKind::MESSAGE && message->is_fixed());
+}
+
+auto Field::element_size() const -> std::size_t
+{
+    return (type_kind == TypeKind::SCALAR) ? scalar->size : message->fixed_size();
+}
+
+struct Schema
+{
+    std::vector<std::string> namespaces;
+    std::deque<Message> messages; // messages are referenced by pointer
+
+    auto find_message(std::string_view name) const -> const Message*
+    {
+        for (const Message& message : messages)
+            if (message.name == name)
+                return &message;
+
+        return nullptr;
+    }
+};
+
+[[noreturn]] void error(const std::string& path, int line, const std::string& msg)
+{
+    std::cerr << path << ":" << line << ": error: " << msg << "\n";
+    std::exit(1);
+}
+
+class Parser
+{
+public:
+    Parser(std::string path, std::string source) : _path(std::move(path)), _source(std::move(source))
+    {
+    }
+
+public:
+    auto parse() -> Schema
+    {
+        Schema schema;
+
+        for (std::string token = next(); !token.empty(); token = next())
+        {
+            if (token == "namespace")
+            {
+                if (!schema.namespaces.empty())
+                    error(_path, _line, "duplicate namespace");
+
+                schema.namespaces.push_back(expect_identifier());
+                for (token = next(); token == "."; token = next())
+                    schema.namespaces.push_back(expect_identifier());
+
+                if (token != ";")
+                    error(_path, _line, "expected ';' after namespace, got '" + token + "'");
+            }
+            else if (token == "message")
+            {
+                parse_message(schema);
+            }
+            else
+            {
+                error(_path, _line, "expected 'namespace' or 'message', got '" + token + "'");
+            }
+        }
+
+        return schema;
+    }
+
+private:
+    void parse_message(Schema& schema)
+    {
+        Message message;
+        message.name = expect_identifier();
+        if (schema.find_message(message.name) || find_scalar(message.name) || message.name == "string")
+            error(_path, _line, "duplicate type name '" + message.name + "'");
+
+        expect("{");
+
+        std::set<std::string> field_names;
+        for (std::string token = next(); token != "}"; token = next())
+        {
+            if (token.empty())
+                error(_path, _line, "unexpected end of file in message '" + message.name + "'");
+
+            Field field;
+            if (const ScalarType* scalar = find_scalar(token))
+            {
+                field.type_kind = TypeKind::SCALAR;
+                field.scalar = scalar;
+            }
+            else if (token == "string")
+            {
+                field.type_kind = TypeKind::STRING;
+            }
+            else if (const Message* nested = schema.find_message(token))
+            {
+                field.type_kind = TypeKind::MESSAGE;
+                field.message = nested;
+            }
+            else
+            {
+                error(_path, _line, "unknown type '" + token + "' (messages must be defined before use)");
+            }
+
+            token = next();
+            if (token == "[")
+            {
+                token = next();
+                if (token == "]")
+                {
+                    if (field.type_kind == TypeKind::SCALAR && field.scalar->name == "bool")
+                        error(_path, _line, "'bool[]' is not supported, use 'u8[]' instead");
+
+                    field.kind = FieldKind::VECTOR;
+                }
+                else
+                {
+                    field.kind = FieldKind::FIXED_ARRAY;
+                    field.count = parse_count(token);
+                    expect("]");
+                }
+                token = next();
+            }
+
+            field.name = token;
+            if (!is_identifier(field.name))
+                error(_path, _line, "expected field name, got '" + field.name + "'");
+            check_cpp_name(field.name);
+            if (std::ranges::find(RESERVED_NAMES, field.name) != std::end(RESERVED_NAMES))
+                error(_path, _line, "field name '" + field.name + "' is reserved");
+            if (!field_names.insert(field.name).second)
+                error(_path, _line, "duplicate field name '" + field.name + "'");
+
+            expect(";");
+            message.fields.push_back(std::move(field));
+        }
+
+        if (message.fields.empty())
+            error(_path, _line, "message '" + message.name + "' has no fields");
+
+        schema.messages.push_back(std::move(message));
+    }
+
+    auto parse_count(const std::string& token) -> std::size_t
+    {
+        const auto is_digit = [](char ch) { return std::isdigit(static_cast<unsigned char>(ch)); };
+        if (token.empty() || token.size() > 6 || !std::all_of(token.begin(), token.end(), is_digit))
+            error(_path, _line, "expected array size, got '" + token + "'");
+
+        const std::size_t count = std::stoul(token);
+        if (count == 0)
+            error(_path, _line, "array size must be positive");
+
+        return count;
+    }
+
+private:
+    static auto find_scalar(std::string_view name) -> const ScalarType*
+    {
+        for (const ScalarType& scalar : SCALAR_TYPES)
+            if (scalar.name == name)
+                return &scalar;
+
+        return nullptr;
+    }
+
+    static bool is_identifier(const std::string& token)
+    {
+        const auto is_alpha = [](char ch) { return std::isalpha(static_cast<unsigned char>(ch)) || ch == '_'; };
+        const auto is_alnum = [](char ch) { return std::isalnum(static_cast<unsigned char>(ch)) || ch == '_'; };
+
+        return !token.empty() && is_alpha(token[0]) && std::all_of(token.begin(), token.end(), is_alnum);
+    }
+
+    /// @brief Errors out if `name` can't be used as a C++ identifier in the generated code.
+    void check_cpp_name(const std::string& name)
+    {
+        if (std::ranges::find(CPP_KEYWORDS, name) != std::end(CPP_KEYWORDS))
+            error(_path, _line, "'" + name + "' is a C++ keyword");
+
+        // `__` anywhere, or `_` followed by an uppercase letter, is reserved for the implementation
+        if (name.find("__") != std::string::npos ||
+            (name.size() >= 2 && name[0] == '_' && std::isupper(static_cast<unsigned char>(name[1]))))
+            error(_path, _line, "'" + name + "' is a reserved identifier in C++");
+    }
+
+    auto expect_identifier() -> std::string
+    {
+        std::string token = next();
+        if (!is_identifier(token))
+            error(_path, _line, "expected identifier, got '" + token + "'");
+        check_cpp_name(token);
+
+        return token;
+    }
+
+    void expect(std::string_view expected)
+    {
+        const std::string token = next();
+        if (token != expected)
+            error(_path, _line, "expected '" + std::string(expected) + "', got '" + token + "'");
+    }
+
+    /// @return Next token, or empty string if end of file
+    auto next() -> std::string
+    {
+        // skip whitespaces & comments
+        while (_pos < _source.size())
+        {
+            if (_source[_pos] == '\n')
+            {
+                ++_line;
+                ++_pos;
+            }
+            else if (std::isspace(static_cast<unsigned char>(_source[_pos])))
+            {
+                ++_pos;
+            }
+            else if (_source.compare(_pos, 2, "//") == 0)
+            {
+                while (_pos < _source.size() && _source[_pos] != '\n')
+                    ++_pos;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (_pos >= _source.size())
+            return {};
+
+        const std::size_t begin = _pos;
+        if (std::isalnum(static_cast<unsigned char>(_source[_pos])) || _source[_pos] == '_')
+        {
+            while (_pos < _source.size() &&
+                   (std::isalnum(static_cast<unsigned char>(_source[_pos])) || _source[_pos] == '_'))
+                ++_pos;
+        }
+        else
+        {
+            ++_pos;
+        }
+
+        return _source.substr(begin, _pos - begin);
+    }
+
+private:
+    std::string _path;
+    std::string _source;
+
+    std::size_t _pos = 0;
+    int _line = 1;
+};
+
+/// @brief C++ type of an element of `field`.
+auto element_type(const Field& field) -> std::string
+{
+    switch (field.type_kind)
+    {
+    case TypeKind::SCALAR:
+        return std::string(field.scalar->cpp_name);
+    case TypeKind::STRING:
+        return "::std::string";
+    case TypeKind::MESSAGE:
+        return field.message->name;
+    }
+    return {};
+}
+
+/// @brief C++ type of `field`.
+auto field_type(const Field& field) -> std::string
+{
+    switch (field.kind)
+    {
+    case FieldKind::SINGLE:
+        return element_type(field);
+    case FieldKind::FIXED_ARRAY:
+        return "::std::array<" + element_type(field) + ", " + std::to_string(field.count) + ">";
+    case FieldKind::VECTOR:
+        return "::std::vector<" + element_type(field) + ">";
+    }
+    return {};
+}
+
+class Generator
+{
+public:
+    explicit Generator(const Schema& schema) : _schema(schema)
+    {
+    }
+
+public:
+    auto header() -> std::string
+    {
+        _out.str({});
+
+        _out << "// Generated by nb_schemac. DO NOT EDIT!\n\n";
+        _out << "#pragma once\n\n";
+        _out << "#include \"NetBuff/SchemaCodec.hpp\"\n\n";
+        _out << "#include <array>\n";
+        _out << "#include <cstddef>\n";
+        _out << "#include <cstdint>\n";
+        _out << "#include <string>\n";
+        _out << "#include <vector>\n\n";
+
+        open_namespace();
+        for (const Message& message : _schema.messages)
+            message_struct(message);
+        close_namespace();
+
+        return _out.str();
+    }
+
+    auto benchmark(const std::string& header_name) -> std::string
+    {
+        _out.str({});
+
+        _out << "// Generated by nb_schemac. DO NOT EDIT!\n";
+        _out << "// `sb_benchmark` entries to encode & decode each message.\n\n";
+        _out << "#include \"" << header_name << "\"\n\n";
+
+        for (const Message& message : _schema.messages)
+        {
+            const std::string type = qualified_name(message);
+            const std::string func = "schema_" + message.name + "_rw";
+
+            _out << "void " << func << "(benchmark::State& state)\n";
+            _out << "{\n";
+            _out << "    " << type << " msg{};\n";
+            for (const Field& field : message.fields)
+            {
+                if (field.type_kind == TypeKind::STRING && field.kind == FieldKind::SINGLE)
+                    _out << "    msg." << field.name << " = \"The quick brown fox jumps over the lazy dog!\";\n";
+                else if (field.kind == FieldKind::VECTOR)
+                    _out << "    msg." << field.name << ".resize(8);\n";
+            }
+            _out << "\n";
+            _out << "    ::nb::SerializeBuffer<> sb(BUF_SIZE);\n\n";
+            _out << "    for (auto _ : state)\n";
+            _out << "    {\n";
+            _out << "        for (int c = 0; c < RW_COUNT; ++c)\n";
+            _out << "        {\n";
+            _out << "            sb.clear();\n";
+            _out << "            msg.try_encode(sb);\n";
+            _out << "            msg.try_decode(sb);\n";
+            _out << "        }\n";
+            _out << "        benchmark::DoNotOptimize(msg);\n";
+            _out << "    }\n";
+            _out << "}\n";
+            _out << "BENCHMARK(" << func << ")->Unit(benchmark::kMicrosecond);\n\n";
+        }
+
+        return _out.str();
+    }
+
+private:
+    void open_namespace()
+    {
+        if (_schema.namespaces.empty())
+            return;
+
+        _out << "namespace ";
+        for (std::size_t idx = 0; idx < _schema.namespaces.size(); ++idx)
+            _out << (idx == 0 ? "" : "::") << _schema.namespaces[idx];
+        _out << "\n{\n\n";
+    }
+
+    void close_namespace()
+    {
+        if (_schema.namespaces.empty())
+            return;
+
+        _out << "} // namespace ";
+        for (std::size_t idx = 0; idx < _schema.namespaces.size(); ++idx)
+            _out << (idx == 0 ? "" : "::") << _schema.namespaces[idx];
+        _out << "\n";
+    }
+
+    auto qualified_name(const Message& message) const -> std::string
+    {
+        std::string name;
+        for (const std::string& ns : _schema.namespaces)
+            name += ns + "::";
+
+        return name + message.name;
+    }
+
+    void message_struct(const Message& message)
+    {
+        _out << "struct " << message.name << "\n";
+        _out << "{\n";
+        for (const Field& field : message.fields)
+            _out << "    " << field_type(field) << " " << field.name << "{};\n";
+        _out << "\n";
+
+        _out << "    /// @brief Sum of the sizes of the fixed-size fields.\n";
+        _out << "    static constexpr ::std::size_t FIXED_SIZE = " << message.fixed_size() << ";\n\n";
+        _out << "    /// @brief Minimum encoded size. (i.e. All strings & variable-size arrays are empty)\n";
+        _out << "    static constexpr ::std::size_t MIN_SIZE = " << message.min_size() << ";\n\n";
+
+        encoded_size(message);
+        if (message.is_fixed())
+            fixed_methods(message);
+        encode(message);
+        decode(message);
+
+        _out << "};\n\n";
+    }
+
+    void encoded_size(const Message& message)
+    {
+        _out << "    auto encoded_size() const -> ::std::size_t\n";
+        _out << "    {\n";
+        if (message.is_fixed())
+        {
+            _out << "        return FIXED_SIZE;\n";
+            _out << "    }\n\n";
+            return;
+        }
+
+        _out << "        ::std::size_t size = FIXED_SIZE;\n";
+        for (const Field& field : message.fields)
+        {
+            if (field.is_fixed())
+                continue;
+
+            const std::string name = "this->" + field.name;
+            const std::string count = "sizeof(::nb::SchemaCodec::CountType)";
+
+            if (field.kind == FieldKind::SINGLE)
+            {
+                if (field.type_kind == TypeKind::STRING)
+                    _out << "        size += " << count << " + " << name << ".size();\n";
+                else
+                    _out << "        size += " << name << ".encoded_size();\n";
+            }
+            else
+            {
+                if (field.kind == FieldKind::VECTOR)
+                    _out << "        size += " << count << ";\n";
+
+                if (field.type_kind == TypeKind::SCALAR)
+                    _out << "        size += " << name << ".size() * " << field.scalar->size << ";\n";
+                else if (field.type_kind == TypeKind::STRING)
+                    _out << "        for (const auto& elem : " << name << ")\n"
+                         << "            size += " << count << " + elem.size();\n";
+                else
+                    _out << "        for (const auto& elem : " << name << ")\n"
+                         << "            size += elem.encoded_size();\n";
+            }
+        }
+        _out << "        return size;\n";
+        _out << "    }\n\n";
+    }
+
+    /// @brief Consecutive fixed-size fields.
+    struct Run
+    {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t size;
+    };
+
+    /// @brief Store the fields in `run` to `dest`.
+    void stores(const Message& message, const Run& run, const std::string& dest, const std::string& indent)
+    {
+        std::size_t offset = 0;
+        for (std::size_t idx = run.begin; idx < run.end; ++idx)
+        {
+            const Field& field = message.fields[idx];
+            const std::string name = "this->" + field.name;
+            const std::string pos = dest + " + " + std::to_string(offset);
+            const std::string elem_pos = pos + " + idx * " + std::to_string(field.element_size());
+
+            if (field.kind == FieldKind::SINGLE && field.type_kind == TypeKind::SCALAR)
+                _out << indent << "::nb::SchemaCodec::store(" << pos << ", " << name << ");\n";
+            else if (field.kind == FieldKind::SINGLE)
+                _out << indent << name << ".store_to(" << pos << ");\n";
+            else
+            {
+                _out << indent << "for (::std::size_t idx = 0; idx < " << field.count << "; ++idx)\n";
+                if (field.type_kind == TypeKind::SCALAR)
+                    _out << indent << "    ::nb::SchemaCodec::store(" << elem_pos << ", " << name << "[idx]);\n";
+                else
+                    _out << indent << "    " << name << "[idx].store_to(" << elem_pos << ");\n";
+            }
+
+            offset += field.fixed_size();
+        }
+    }
+
+    /// @brief Load the fields in `run` from `src`.
+    void loads(const Message& message, const Run& run, const std::string& src, const std::string& indent)
+    {
+        std::size_t offset = 0;
+        for (std::size_t idx = run.begin; idx < run.end; ++idx)
+        {
+            const Field& field = message.fields[idx];
+            const std::string name = "this->" + field.name;
+            const std::string pos = src + " + " + std::to_string(offset);
+            const std::string elem_pos = pos + " + idx * " + std::to_string(field.element_size());
+            const std::string load = (field.type_kind == TypeKind::SCALAR)
+                                         ? "::nb::SchemaCodec::load<" + std::string(field.scalar->cpp_name) + ">"
+                                         : std::string();
+
+            if (field.kind == FieldKind::SINGLE && field.type_kind == TypeKind::SCALAR)
+                _out << indent << name << " = " << load << "(" << pos << ");\n";
+            else if (field.kind == FieldKind::SINGLE)
+                _out << indent << name << ".load_from(" << pos << ");\n";
+            else
+            {
+                _out << indent << "for (::std::size_t idx = 0; idx < " << field.count << "; ++idx)\n";
+                if (field.type_kind == TypeKind::SCALAR)
+                    _out << indent << "    " << name << "[idx] = " << load << "(" << elem_pos << ");\n";
+                else
+                    _out << indent << "    " << name << "[idx].load_from(" << elem_pos << ");\n";
+            }
+
+            offset += field.fixed_size();
+        }
+    }
+
+    /// @brief Methods to coalesce a fixed-size message with the adjacent fields of its parent.
+    void fixed_methods(const Message& message)
+    {
+        const Run run{0, message.fields.size(), message.fixed_size()};
+
+        _out << "    /// @brief Store to `dest`, which has `FIXED_SIZE` bytes.\n";
+        _out << "    void store_to(::std::byte* dest) const\n";
+        _out << "    {\n";
+        stores(message, run, "dest", "        ");
+        _out << "    }\n\n";
+
+        _out << "    /// @brief Load from `src`, which has `FIXED_SIZE` bytes.\n";
+        _out << "    void load_from(const ::std::byte* src)\n";
+        _out << "    {\n";
+        loads(message, run, "src", "        ");
+        _out << "    }\n\n";
+    }
+
+    static auto find_run(const Message& message, std::size_t begin) -> Run
+    {
+        Run run{begin, begin, 0};
+        while (run.end < message.fields.size() && message.fields[run.end].is_fixed())
+            run.size += message.fields[run.end++].fixed_size();
+
+        return run;
+    }
+
+    void encode(const Message& message)
+    {
+        _out << "    /// @brief Write this message to `buf`.\n";
+        _out << "    ///\n";
+        _out << "    /// If failed, the fields before the failed one are left written to `buf`.\n";
+        _out << "    template <typename Buffer>\n";
+        _out << "    bool try_encode(Buffer& buf) const\n";
+        _out << "    {\n";
+
+        for (std::size_t idx = 0; idx < message.fields.size();)
+        {
+            const Run run = find_run(message, idx);
+            if (run.size != 0)
+            {
+                _out << "        {\n";
+                _out << "            ::std::array<::std::byte, " << run.size << "> run;\n";
+                stores(message, run, "run.data()", "            ");
+                _out << "            if (!buf.try_write(run.data(), run.size()))\n";
+                _out << "                return false;\n";
+                _out << "        }\n";
+
+                idx = run.end;
+                continue;
+            }
+
+            const Field& field = message.fields[idx++];
+            const std::string name = "this->" + field.name;
+
+            if (field.kind == FieldKind::VECTOR && field.type_kind == TypeKind::SCALAR)
+            {
+                _out << "        if (!::nb::SchemaCodec::try_write_vector(buf, " << name << "))\n";
+                _out << "            return false;\n";
+                continue;
+            }
+
+            std::string indent = "        ";
+            std::string elem = name;
+            if (field.kind != FieldKind::SINGLE)
+            {
+                if (field.kind == FieldKind::VECTOR)
+                {
+                    _out << "        if (!::nb::SchemaCodec::try_write_count(buf, " << name << ".size()))\n";
+                    _out << "            return false;\n";
+                }
+                _out << "        for (const auto& elem : " << name << ")\n";
+                indent += "    ";
+                elem = "elem";
+            }
+
+            if (field.type_kind == TypeKind::STRING)
+                _out << indent << "if (!buf.try_write(" << elem << "))\n";
+            else
+                _out << indent << "if (!" << elem << ".try_encode(buf))\n";
+            _out << indent << "    return false;\n";
+        }
+
+        _out << "        return true;\n";
+        _out << "    }\n\n";
+    }
+
+    void decode(const Message& message)
+    {
+        _out << "    /// @brief Read this message from `buf`.\n";
+        _out << "    ///\n";
+        _out << "    /// If failed, the fields before the failed one are left read from `buf`.\n";
+        _out << "    template <typename Buffer>\n";
+        _out << "    bool try_decode(Buffer& buf)\n";
+        _out << "    {\n";
+
+        for (std::size_t idx = 0; idx < message.fields.size();)
+        {
+            const Run run = find_run(message, idx);
+            if (run.size != 0)
+            {
+                _out << "        {\n";
+                _out << "            ::std::array<::std::byte, " << run.size << "> run;\n";
+                _out << "            if (!buf.try_read(run.data(), run.size()))\n";
+                _out << "                return false;\n";
+                loads(message, run, "run.data()", "            ");
+                _out << "        }\n";
+
+                idx = run.end;
+                continue;
+            }
+
+            const Field& field = message.fields[idx++];
+            const std::string name = "this->" + field.name;
+
+            if (field.kind == FieldKind::VECTOR && field.type_kind == TypeKind::SCALAR)
+            {
+                _out << "        if (!::nb::SchemaCodec::try_read_vector(buf, " << name << "))\n";
+                _out << "            return false;\n";
+                continue;
+            }
+
+            std::string indent = "        ";
+            std::string elem = name;
+            if (field.kind != FieldKind::SINGLE)
+            {
+                if (field.kind == FieldKind::VECTOR)
+                {
+                    const std::string min_size = (field.type_kind == TypeKind::STRING)
+                                                     ? "sizeof(::nb::SchemaCodec::CountType)"
+                                                     : field.message->name + "::MIN_SIZE";
+
+                    _out << "        {\n";
+                    _out << "            ::std::size_t count;\n";
+                    _out << "            if (!::nb::SchemaCodec::try_read_count(buf, count, " << min_size << "))\n";
+                    _out << "                return false;\n";
+                    _out << "            " << name << ".resize(count);\n";
+                    _out << "        }\n";
+                }
+                _out << "        for (auto& elem : " << name << ")\n";
+                indent += "    ";
+                elem = "elem";
+            }
+
+            if (field.type_kind == TypeKind::STRING)
+                _out << indent << "if (!buf.try_read(" << elem << "))\n";
+            else
+                _out << indent << "if (!" << elem << ".try_decode(buf))\n";
+            _out << indent << "    return false;\n";
+        }
+
+        _out << "        return true;\n";
+        _out << "    }\n";
+    }
+
+private:
+    const Schema& _schema;
+    std::ostringstream _out;
+};
+
+bool write_file(const std::string& path, const std::string& content)
+{
+    // don't touch the file if not changed, to avoid rebuilding the dependents
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (in)
+        {
+            std::ostringstream existing;
+            existing << in.rdbuf();
+            if (existing.str() == content)
+                return true;
+        }
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+    return static_cast<bool>(out);
+}
+
+auto file_name(const std::string& path) -> std::string
+{
+    const std::size_t pos = path.find_last_of("/\\");
+    return (pos == std::string::npos) ? path : path.substr(pos + 1);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string schema_path;
+    std::string header_path;
+    std::string benchmark_path;
+    bool valid_args = true;
+
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        const std::string_view arg = argv[idx];
+        if (arg == "-o" && idx + 1 < argc)
+            header_path = argv[++idx];
+        else if (arg == "--benchmark" && idx + 1 < argc)
+            benchmark_path = argv[++idx];
+        else if (schema_path.empty())
+            schema_path = arg;
+        else
+            valid_args = false;
+    }
+
+    if (!valid_args || schema_path.empty() || header_path.empty())
+    {
+        std::cerr << "Usage: nb_schemac <schema> -o <header> [--benchmark <benchmark.inc>]\n";
+        return 2;
+    }
+
+    std::ifstream in(schema_path, std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "Failed to open " << schema_path << "\n";
+        return 1;
+    }
+    std::ostringstream source;
+    source << in.rdbuf();
+
+    const Schema schema = Parser(schema_path, source.str()).parse();
+    Generator generator(schema);
+
+    if (!write_file(header_path, generator.header()))
+    {
+        std::cerr << "Failed to write " << header_path << "\n";
+        return 1;
+    }
+    if (!benchmark_path.empty() && !write_file(benchmark_path, generator.benchmark(file_name(header_path))))
+    {
+        std::cerr << "Failed to write " << benchmark_path << "\n";
+        return 1;
+    }
+}